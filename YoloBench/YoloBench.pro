@@ -0,0 +1,55 @@
+QT       += core gui
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../YoloWebCam
+INCLUDEPATH += /usr/local/include/opencv4
+LIBS += -L/usr/local/lib \
+    -lopencv_core \
+    -lopencv_imgproc \
+    -lopencv_imgcodecs \
+    -lopencv_videoio \
+    -lopencv_dnn \
+    -lopencv_video
+
+trace: DEFINES += YOLO_TRACE
+
+SOURCES += \
+    benchstats.cpp \
+    decodebench.cpp \
+    main.cpp \
+    poolbench.cpp \
+    preprocessbench.cpp \
+    stagebench.cpp \
+    tilebench.cpp \
+    ../YoloWebCam/autotuner.cpp \
+    ../YoloWebCam/batchdetector.cpp \
+    ../YoloWebCam/framepool.cpp \
+    ../YoloWebCam/inferencepool.cpp \
+    ../YoloWebCam/inferenceworker.cpp \
+    ../YoloWebCam/modelloader.cpp \
+    ../YoloWebCam/objecttracker.cpp \
+    ../YoloWebCam/preprocessor.cpp \
+    ../YoloWebCam/resolutioncontroller.cpp \
+    ../YoloWebCam/tileddetector.cpp \
+    ../YoloWebCam/tracing.cpp \
+    ../YoloWebCam/yolodecoder.cpp
+
+HEADERS += \
+    benchmarks.h \
+    benchstats.h \
+    ../YoloWebCam/autotuner.h \
+    ../YoloWebCam/batchdetector.h \
+    ../YoloWebCam/framemailbox.h \
+    ../YoloWebCam/framepool.h \
+    ../YoloWebCam/inferencepool.h \
+    ../YoloWebCam/inferenceworker.h \
+    ../YoloWebCam/modelloader.h \
+    ../YoloWebCam/objecttracker.h \
+    ../YoloWebCam/preprocessor.h \
+    ../YoloWebCam/resolutioncontroller.h \
+    ../YoloWebCam/tileddetector.h \
+    ../YoloWebCam/tracing.h \
+    ../YoloWebCam/yololabel.h \
+    ../YoloWebCam/yolodecoder.h
@@ -0,0 +1,14 @@
+// benchmarks.h
+#pragma once
+#include <QStringList>
+#include <opencv2/core.hpp>
+
+// 각 벤치마크 진입점. args 에는 서브커맨드 이후 인자만 들어온다
+int runDecodeBench(const QStringList &args);
+int runPreprocessBench(const QStringList &args);
+int runPoolBench(const QStringList &args);
+int runStageBench(const QStringList &args);
+int runTileBench(const QStringList &args);
+
+// 실제 YOLOv8 출력과 비슷한 (1, 4+nc, anchors) 합성 텐서 (decodebench.cpp)
+cv::Mat makeSyntheticOutput(int numClasses, int anchors, int objects, cv::RNG &rng);
@@ -0,0 +1,87 @@
+// benchstats.cpp
+#include "benchstats.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+#include <cstdio>
+
+static double percentile(const std::vector<double> &sorted, double p)
+{
+    if (sorted.empty())
+        return 0;
+    const size_t index = std::min(sorted.size() - 1, size_t(p * (sorted.size() - 1) + 0.5));
+    return sorted[index];
+}
+
+StageStats summarize(const QString &stage, const QString &resolution, std::vector<double> times)
+{
+    StageStats stats;
+    stats.stage = stage;
+    stats.resolution = resolution;
+    stats.samples = int(times.size());
+    if (times.empty())
+        return stats;
+
+    std::sort(times.begin(), times.end());
+    double sum = 0;
+    for (double t : times)
+        sum += t;
+
+    stats.mean = sum / times.size();
+    stats.p50 = percentile(times, 0.50);
+    stats.p95 = percentile(times, 0.95);
+    stats.p99 = percentile(times, 0.99);
+    stats.fps = stats.mean > 0 ? 1000.0 / stats.mean : 0;
+    return stats;
+}
+
+FILE *reportStream(const QString &jsonPath)
+{
+    return jsonPath == "-" ? stderr : stdout;
+}
+
+void printStats(const StageStats &stats, FILE *out)
+{
+    std::fprintf(out, "%-10s %-24s p50 %8.3f  p95 %8.3f  p99 %8.3f ms  %9.1f /s\n",
+                qPrintable(stats.resolution), qPrintable(stats.stage),
+                stats.p50, stats.p95, stats.p99, stats.fps);
+}
+
+QJsonArray toJson(const std::vector<StageStats> &results)
+{
+    QJsonArray array;
+    for (const StageStats &stats : results) {
+        QJsonObject object;
+        object["stage"] = stats.stage;
+        object["resolution"] = stats.resolution;
+        object["samples"] = stats.samples;
+        object["mean_ms"] = stats.mean;
+        object["p50_ms"] = stats.p50;
+        object["p95_ms"] = stats.p95;
+        object["p99_ms"] = stats.p99;
+        object["throughput_per_s"] = stats.fps;
+        if (stats.recall >= 0) {
+            object["recall"] = stats.recall;
+            object["precision"] = stats.precision;
+        }
+        array.append(object);
+    }
+    return array;
+}
+
+bool writeJson(const QString &path, const std::vector<StageStats> &results)
+{
+    const QByteArray json = QJsonDocument(toJson(results)).toJson();
+    if (path == "-") {
+        std::fwrite(json.constData(), 1, size_t(json.size()), stdout);
+        return true;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    file.write(json);
+    return true;
+}
@@ -0,0 +1,45 @@
+// benchstats.h
+#pragma once
+#include <QJsonArray>
+#include <QString>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// 한 단계의 지연 시간 분포 (ms)
+struct StageStats {
+    QString stage;
+    QString resolution;
+    int samples = 0;
+    double mean = 0;
+    double p50 = 0;
+    double p95 = 0;
+    double p99 = 0;
+    double fps = 0;     // 1000 / mean
+    double recall = -1;     // 라벨로 채점한 경우만 (tiles), 음수면 JSON 에 넣지 않는다
+    double precision = -1;
+};
+
+StageStats summarize(const QString &stage, const QString &resolution, std::vector<double> times);
+
+// fn(i) 를 iters 번 실행해 각 실행 시간 (ms) 을 모은다
+template <typename Fn>
+std::vector<double> measure(int iters, Fn fn)
+{
+    std::vector<double> times;
+    times.reserve(iters);
+    for (int i = 0; i < iters; ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        fn(i);
+        auto end = std::chrono::high_resolution_clock::now();
+        times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return times;
+}
+
+// 사람이 읽는 표 / 회귀 비교용 JSON.
+// --json - 이면 stdout 에는 JSON 만 남도록 표는 reportStream 이 돌려주는 stderr 로
+FILE *reportStream(const QString &jsonPath);
+void printStats(const StageStats &stats, FILE *out = stdout);
+QJsonArray toJson(const std::vector<StageStats> &results);
+bool writeJson(const QString &path, const std::vector<StageStats> &results);
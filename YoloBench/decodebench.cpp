@@ -0,0 +1,88 @@
+// decodebench.cpp
+#include "benchmarks.h"
+#include "yolodecoder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <opencv2/core.hpp>
+
+// 실제 YOLOv8 출력과 비슷한 합성 텐서: 대부분 낮은 점수 + 물체 주변에 높은 점수 앵커가 몰려 있음
+cv::Mat makeSyntheticOutput(int numClasses, int anchors, int objects, cv::RNG &rng)
+{
+    const int sizes[] = { 1, 4 + numClasses, anchors };
+    cv::Mat output(3, sizes, CV_32F);
+    float *data = output.ptr<float>();
+
+    for (int a = 0; a < anchors; ++a) {
+        data[a] = rng.uniform(0.f, 640.f);
+        data[anchors + a] = rng.uniform(0.f, 640.f);
+        data[2 * anchors + a] = rng.uniform(4.f, 200.f);
+        data[3 * anchors + a] = rng.uniform(4.f, 200.f);
+    }
+    float *scores = data + 4 * anchors;
+    for (int i = 0; i < numClasses * anchors; ++i)
+        scores[i] = rng.uniform(0.f, 0.05f);
+
+    // 물체 하나당 20개 안팎의 앵커가 비슷한 박스 / 높은 점수를 가짐 → NMS 부하
+    for (int o = 0; o < objects; ++o) {
+        const float cx = rng.uniform(50.f, 590.f);
+        const float cy = rng.uniform(50.f, 590.f);
+        const float w = rng.uniform(20.f, 150.f);
+        const float h = rng.uniform(20.f, 150.f);
+        const int cls = rng.uniform(0, numClasses);
+        for (int k = 0; k < 20; ++k) {
+            const int a = rng.uniform(0, anchors);
+            data[a] = cx + rng.uniform(-4.f, 4.f);
+            data[anchors + a] = cy + rng.uniform(-4.f, 4.f);
+            data[2 * anchors + a] = w + rng.uniform(-4.f, 4.f);
+            data[3 * anchors + a] = h + rng.uniform(-4.f, 4.f);
+            scores[cls * anchors + a] = rng.uniform(0.3f, 0.95f);
+        }
+    }
+    return output;
+}
+
+static void benchOne(int numClasses, int anchors, int iters)
+{
+    cv::RNG rng(12345);
+    cv::Mat output = makeSyntheticOutput(numClasses, anchors, 30, rng);
+
+    YoloDecoder decoder;
+    std::vector<Detection> detections;
+
+    for (int i = 0; i < 10; ++i)  // 워밍업 (작업 버퍼 확보)
+        decoder.decode(output, detections);
+
+    std::vector<double> times;
+    times.reserve(iters);
+    for (int i = 0; i < iters; ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        decoder.decode(output, detections);
+        auto end = std::chrono::high_resolution_clock::now();
+        times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    std::sort(times.begin(), times.end());
+    double sum = 0;
+    for (double t : times) sum += t;
+
+    std::printf("nc=%-3d anchors=%d  mean %.3f ms  p50 %.3f ms  p95 %.3f ms  detections %zu\n",
+                numClasses, anchors, sum / iters, times[iters / 2], times[iters * 95 / 100], detections.size());
+}
+
+int runDecodeBench(const QStringList &args)
+{
+    int iters = 500;
+    int anchors = 8400;
+    for (int i = 0; i + 1 < args.size(); i += 2) {
+        if (args[i] == "--iters") iters = std::max(1, args[i + 1].toInt());
+        else if (args[i] == "--anchors") anchors = std::max(1, args[i + 1].toInt());
+    }
+
+    std::printf("decode + NMS per frame (%d iterations)\n", iters);
+    benchOne(1, anchors, iters);   // best.onnx
+    benchOne(80, anchors, iters);  // COCO
+    return 0;
+}
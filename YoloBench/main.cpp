@@ -0,0 +1,54 @@
+// main.cpp
+#include "benchmarks.h"
+#include "framepool.h"
+#include "yolodecoder.h"
+
+#include <QGuiApplication>
+#include <QMetaType>
+#include <cstdio>
+
+static void printUsage()
+{
+    std::printf("usage: YoloBench <benchmark> [options]\n\n");
+    std::printf("  decode [--iters N] [--anchors N]   YOLOv8 출력 디코딩 + NMS (nc=1, nc=80)\n");
+    std::printf("  preprocess [--iters N]             blobFromImage vs 레터박스 전처리 (480p/720p/1080p)\n");
+    std::printf("  pool --model PATH [--cores N] [--frames N]  추론 워커 x 스레드 조합별 처리량\n");
+    std::printf("  stages [--iters N] [--model PATH] [--video PATH] [--label WxH] [--json PATH|-]\n");
+    std::printf("                                     단계별 p50/p95/p99 + 처리량 (480p/720p/1080p)\n");
+    std::printf("  tiles --model PATH [--iters N] [--dataset ROOT] [--split val] [--limit N] [--tile-size 640] [--overlap 0.2]\n");
+    std::printf("        [--tile-batch 1] [--iou 0.5] [--json PATH|-]\n");
+    std::printf("                                     한 장 추론 vs 타일 추론 recall / precision / 처리량\n");
+}
+
+int main(int argc, char *argv[])
+{
+    qRegisterMetaType<std::vector<Detection>>("std::vector<Detection>");
+    qRegisterMetaType<FramePtr>("FramePtr");
+
+    // setImage 단계에서 QPixmap 을 쓰므로 GUI 앱이 필요 (디스플레이 없는 서버에서도 돌도록 offscreen)
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+
+    QStringList args = app.arguments();
+    args.removeFirst();
+    if (args.isEmpty()) {
+        printUsage();
+        return 1;
+    }
+
+    const QString name = args.takeFirst();
+    if (name == "decode")
+        return runDecodeBench(args);
+    if (name == "preprocess")
+        return runPreprocessBench(args);
+    if (name == "pool")
+        return runPoolBench(args);
+    if (name == "stages")
+        return runStageBench(args);
+    if (name == "tiles")
+        return runTileBench(args);
+
+    printUsage();
+    return 1;
+}
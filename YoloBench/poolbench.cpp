@@ -0,0 +1,108 @@
+// poolbench.cpp
+#include "benchmarks.h"
+#include "inferencepool.h"
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QThread>
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <opencv2/core.hpp>
+#include <opencv2/dnn.hpp>
+
+// 같은 이미지 데이터를 공유하되 sequence 만 다른 프레임
+static FramePtr makeFrame(const cv::Mat &image, quint64 sequence)
+{
+    std::shared_ptr<Frame> frame = std::make_shared<Frame>();
+    frame->image = image;
+    frame->sequence = sequence;
+    frame->timestampUs = frameClockUs();
+    return frame;
+}
+
+// 워커 수만큼 프레임을 계속 물려서 total 개 처리하는 데 걸린 시간 (ms)
+static double runFrames(InferencePool &pool, const cv::Mat &image, quint64 &sequence, int total)
+{
+    QEventLoop loop;
+    int submitted = 0;
+    int completed = 0;
+    double forwardMs = 0;
+
+    QMetaObject::Connection connection = QObject::connect(&pool, &InferencePool::inferenceCompleted, &loop,
+        [&](const FramePtr &, const std::vector<Detection> &, double time) {
+            forwardMs += time;
+            if (++completed == total) {
+                loop.quit();
+            } else if (submitted < total) {
+                pool.submitFrame(makeFrame(image, ++sequence));
+                submitted++;
+            }
+        });
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < pool.workerCount() && submitted < total; ++i) {
+        pool.submitFrame(makeFrame(image, ++sequence));
+        submitted++;
+    }
+    loop.exec();
+    const double elapsed = timer.nsecsElapsed() / 1e6;
+
+    QObject::disconnect(connection);
+    std::printf("    avg per-frame worker time %.2f ms\n", forwardMs / total);
+    return elapsed;
+}
+
+int runPoolBench(const QStringList &args)
+{
+    QString model;
+    int cores = QThread::idealThreadCount();
+    int frames = 200;
+    for (int i = 0; i + 1 < args.size(); i += 2) {
+        if (args[i] == "--model") model = args[i + 1];
+        else if (args[i] == "--cores") cores = std::max(1, args[i + 1].toInt());
+        else if (args[i] == "--frames") frames = std::max(1, args[i + 1].toInt());
+    }
+    if (model.isEmpty()) {
+        std::printf("pool: --model <path to onnx> is required\n");
+        return 1;
+    }
+
+    cv::Mat image(720, 1280, CV_8UC3);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+
+    std::printf("workers x threads split for %d cores, %d frames (1280x720)\n", cores, frames);
+
+    double bestFps = 0;
+    int bestWorkers = 1;
+    quint64 sequence = 0;
+    for (int workers = 1; workers <= cores; ++workers) {
+        if (cores % workers != 0)
+            continue;
+
+        InferenceSettings settings;
+        settings.workers = workers;
+        settings.threadsPerWorker = cores / workers;
+
+        InferencePool pool(settings);
+        if (!pool.loadModel(model, cv::dnn::DNN_BACKEND_OPENCV, cv::dnn::DNN_TARGET_CPU)) {
+            std::printf("failed to load %s\n", qPrintable(model));
+            return 1;
+        }
+
+        std::printf("  %2d workers x %2d threads\n", workers, settings.threadsPerWorker);
+        runFrames(pool, image, sequence, workers * 2);  // 워밍업
+        const double elapsed = runFrames(pool, image, sequence, frames);
+        const double fps = frames * 1000.0 / elapsed;
+        std::printf("    throughput %.1f fps\n", fps);
+
+        if (fps > bestFps) {
+            bestFps = fps;
+            bestWorkers = workers;
+        }
+    }
+
+    std::printf("best: --workers %d --threads %d (%.1f fps)\n", bestWorkers, cores / bestWorkers, bestFps);
+    return 0;
+}
@@ -0,0 +1,59 @@
+// preprocessbench.cpp
+#include "benchmarks.h"
+#include "preprocessor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <opencv2/core.hpp>
+#include <opencv2/dnn.hpp>
+
+template <typename Fn>
+static double medianMs(int iters, Fn fn)
+{
+    std::vector<double> times;
+    times.reserve(iters);
+    for (int i = 0; i < iters; ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        fn();
+        auto end = std::chrono::high_resolution_clock::now();
+        times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[iters / 2];
+}
+
+int runPreprocessBench(const QStringList &args)
+{
+    int iters = 200;
+    for (int i = 0; i + 1 < args.size(); i += 2) {
+        if (args[i] == "--iters") iters = std::max(1, args[i + 1].toInt());
+    }
+
+    const cv::Size sources[] = { cv::Size(640, 480), cv::Size(1280, 720), cv::Size(1920, 1080) };
+
+    std::printf("preprocess per frame, median of %d iterations\n", iters);
+    for (const cv::Size &source : sources) {
+        cv::Mat frame(source, CV_8UC3);
+        cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(255));
+
+        // 기존 경로: 매 프레임 새 blob (stretch)
+        cv::Mat blob;
+        const double stretch = medianMs(iters, [&]() {
+            blob = cv::dnn::blobFromImage(frame, 1 / 255.0, cv::Size(640, 640), cv::Scalar(), true, false);
+        });
+
+        // 레터박스 경로: 재사용 버퍼
+        Preprocessor preprocessor(640);
+        LetterboxInfo info;
+        preprocessor.process(frame, info);
+        const double letterbox = medianMs(iters, [&]() {
+            preprocessor.process(frame, info);
+        });
+
+        std::printf("%4dx%-4d  blobFromImage %.3f ms  letterbox %.3f ms  (x%.2f)\n",
+                    source.width, source.height, stretch, letterbox, stretch / letterbox);
+    }
+    return 0;
+}
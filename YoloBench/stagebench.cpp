@@ -0,0 +1,195 @@
+// stagebench.cpp
+#include "benchmarks.h"
+#include "benchstats.h"
+#include "framepool.h"
+#include "preprocessor.h"
+#include "yolodecoder.h"
+
+#include <QImage>
+#include <QPainter>
+#include <QPixmap>
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include <opencv2/dnn.hpp>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/videoio.hpp>
+
+struct Resolution {
+    const char *name;
+    cv::Size size;
+};
+
+// 합성 프레임 또는 녹화 영상에서 읽은 프레임을 해상도에 맞게 준비
+static std::vector<FramePtr> makeFrames(const std::vector<cv::Mat> &video, const cv::Size &size)
+{
+    std::vector<FramePtr> frames;
+    if (video.empty()) {
+        for (int i = 0; i < 8; ++i) {
+            std::shared_ptr<Frame> frame = std::make_shared<Frame>();
+            frame->image.create(size, CV_8UC3);
+            cv::randu(frame->image, cv::Scalar::all(0), cv::Scalar::all(255));
+            frame->sequence = quint64(i + 1);
+            frames.push_back(frame);
+        }
+        return frames;
+    }
+
+    for (size_t i = 0; i < video.size(); ++i) {
+        std::shared_ptr<Frame> frame = std::make_shared<Frame>();
+        cv::resize(video[i], frame->image, size, 0, 0, cv::INTER_AREA);
+        frame->sequence = quint64(i + 1);
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+static std::vector<cv::Mat> readVideo(const QString &path, int maxFrames)
+{
+    std::vector<cv::Mat> video;
+    cv::VideoCapture cap(path.toStdString());
+    cv::Mat frame;
+    while (int(video.size()) < maxFrames && cap.read(frame) && !frame.empty())
+        video.push_back(frame.clone());
+    return video;
+}
+
+int runStageBench(const QStringList &args)
+{
+    int iters = 100;
+    QString model;
+    QString videoPath;
+    QString jsonPath;
+    QSize labelSize(960, 540);
+    for (int i = 0; i + 1 < args.size(); i += 2) {
+        if (args[i] == "--iters") iters = std::max(1, args[i + 1].toInt());
+        else if (args[i] == "--model") model = args[i + 1];
+        else if (args[i] == "--video") videoPath = args[i + 1];
+        else if (args[i] == "--json") jsonPath = args[i + 1];
+        else if (args[i] == "--label") {
+            const QStringList wh = args[i + 1].split('x');
+            if (wh.size() == 2) labelSize = QSize(wh[0].toInt(), wh[1].toInt());
+        }
+    }
+
+    FILE *out = reportStream(jsonPath);
+
+    std::vector<cv::Mat> video;
+    if (!videoPath.isEmpty()) {
+        video = readVideo(videoPath, 64);
+        if (video.empty()) {
+            std::fprintf(out, "failed to read %s\n", qPrintable(videoPath));
+            return 1;
+        }
+    }
+
+    cv::dnn::Net net;
+    std::vector<cv::String> outputNames;
+    if (!model.isEmpty()) {
+        net = cv::dnn::readNetFromONNX(model.toStdString());
+        if (net.empty()) {
+            std::fprintf(out, "failed to load %s\n", qPrintable(model));
+            return 1;
+        }
+        net.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+        net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+        outputNames = net.getUnconnectedOutLayersNames();
+    }
+
+    const Resolution resolutions[] = {
+        { "480p", cv::Size(640, 480) },
+        { "720p", cv::Size(1280, 720) },
+        { "1080p", cv::Size(1920, 1080) },
+    };
+
+    std::fprintf(out, "per-stage latency, %d iterations, %s frames\n", iters, video.empty() ? "synthetic" : "recorded");
+
+    std::vector<StageStats> results;
+    auto report = [&](const char *stage, const char *resolution, const std::vector<double> &times) {
+        results.push_back(summarize(stage, resolution, times));
+        printStats(results.back(), out);
+    };
+
+    for (const Resolution &res : resolutions) {
+        const std::vector<FramePtr> frames = makeFrames(video, res.size);
+        auto frameAt = [&](int i) -> const FramePtr & { return frames[size_t(i) % frames.size()]; };
+
+        // 1. 캡처 변환: 예전 BGR→RGB + QImage 복사 vs 지금의 공유 버퍼 래핑
+        cv::Mat rgb;
+        report("capture_cvtcolor_copy", res.name, measure(iters, [&](int i) {
+            cv::cvtColor(frameAt(i)->image, rgb, cv::COLOR_BGR2RGB);
+            QImage image(rgb.data, rgb.cols, rgb.rows, int(rgb.step), QImage::Format_RGB888);
+            QImage copy = image.copy();
+            Q_UNUSED(copy);
+        }));
+        report("capture_wrap", res.name, measure(iters, [&](int i) {
+            QImage image = frameToQImage(frameAt(i));
+            Q_UNUSED(image);
+        }));
+
+        // 2. 전처리
+        cv::Mat blob;
+        report("preprocess_blobfromimage", res.name, measure(iters, [&](int i) {
+            blob = cv::dnn::blobFromImage(frameAt(i)->image, 1 / 255.0, cv::Size(640, 640), cv::Scalar(), true, false);
+        }));
+        Preprocessor preprocessor(640);
+        LetterboxInfo letterbox;
+        report("preprocess_letterbox", res.name, measure(iters, [&](int i) {
+            preprocessor.process(frameAt(i)->image, letterbox);
+        }));
+
+        // 3. net.forward (모델이 있을 때만)
+        std::vector<cv::Mat> outputs;
+        if (!net.empty()) {
+            net.setInput(preprocessor.process(frameAt(0)->image, letterbox));
+            net.forward(outputs, outputNames);  // 워밍업
+            report("forward", res.name, measure(iters, [&](int i) {
+                net.setInput(preprocessor.process(frameAt(i)->image, letterbox));
+                net.forward(outputs, outputNames);
+            }));
+        } else {
+            cv::RNG rng(12345);
+            outputs.assign(1, makeSyntheticOutput(1, 8400, 30, rng));
+        }
+
+        // 4. 후처리 (디코딩 + NMS + 원본 좌표 변환)
+        YoloDecoder decoder;
+        std::vector<Detection> detections;
+        const cv::Rect2f bounds(0.f, 0.f, float(res.size.width), float(res.size.height));
+        report("postprocess", res.name, measure(iters, [&](int) {
+            decoder.decode(outputs[0], detections);
+            for (Detection &det : detections)
+                det.box = letterbox.toSource(det.box) & bounds;
+        }));
+
+        // 5. 결과 QImage 변환 + 박스 그리기 (onInferenceCompleted)
+        QImage annotated;
+        report("qimage_annotate", res.name, measure(iters, [&](int i) {
+            annotated = frameToQImage(frameAt(i)).convertToFormat(QImage::Format_RGB888);
+            QPainter painter(&annotated);
+            painter.setPen(QPen(Qt::red, 2));
+            for (const Detection &det : detections)
+                painter.drawRect(QRectF(det.box.x, det.box.y, det.box.width, det.box.height));
+        }));
+
+        // 6. setImage: QPixmap 변환 + 라벨 크기로 SmoothTransformation 스케일
+        report("setimage_scale", res.name, measure(iters, [&](int) {
+            QPixmap pixmap = QPixmap::fromImage(annotated);
+            QPixmap scaled = pixmap.scaled(labelSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+            Q_UNUSED(scaled);
+        }));
+
+        // 6'. 지금의 표시 경로: 표시 스레드에서 QImage 를 FastTransformation 으로 축소
+        report("display_fast_scale", res.name, measure(iters, [&](int) {
+            QImage scaled = annotated.scaled(labelSize, Qt::KeepAspectRatio, Qt::FastTransformation);
+            Q_UNUSED(scaled);
+        }));
+    }
+
+    if (!jsonPath.isEmpty() && !writeJson(jsonPath, results)) {
+        std::fprintf(out, "failed to write %s\n", qPrintable(jsonPath));
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,240 @@
+// tilebench.cpp
+#include "benchmarks.h"
+#include "benchstats.h"
+#include "batchdetector.h"
+#include "modelloader.h"
+#include "tileddetector.h"
+#include "yololabel.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+#include <opencv2/dnn.hpp>
+#include <opencv2/imgcodecs.hpp>
+
+struct Sample {
+    cv::Mat image;
+    std::vector<Detection> truth;   // 라벨 (원본 픽셀 좌표, confidence 없음)
+};
+
+// 같은 해상도 / 같은 split 끼리 한 줄로 통계를 낸다
+struct SampleGroup {
+    QString resolution;
+    std::vector<Sample> samples;
+};
+
+struct Accuracy {
+    int truth = 0;
+    int detected = 0;
+    int matched = 0;
+};
+
+static std::vector<Sample> readDataset(const QString &root, const QString &split, int limit)
+{
+    std::vector<Sample> samples;
+    QDir images(root + "/images/" + split);
+    const QStringList files = images.entryList({ "*.jpg", "*.jpeg", "*.png", "*.bmp" }, QDir::Files, QDir::Name);
+    for (const QString &file : files) {
+        if (int(samples.size()) >= limit)
+            break;
+
+        Sample sample;
+        sample.image = cv::imread(images.filePath(file).toStdString());
+        if (sample.image.empty())
+            continue;
+
+        const QString labelPath = root + "/labels/" + split + "/" + QFileInfo(file).completeBaseName() + ".txt";
+        for (const YoloLabel &label : readYoloLabels(labelPath)) {
+            Detection det;
+            det.classId = label.classId;
+            det.confidence = 1.f;
+            det.box = cv::Rect2f(float((label.xCenter - label.width / 2) * sample.image.cols),
+                                 float((label.yCenter - label.height / 2) * sample.image.rows),
+                                 float(label.width * sample.image.cols),
+                                 float(label.height * sample.image.rows));
+            sample.truth.push_back(det);
+        }
+        samples.push_back(sample);
+    }
+    return samples;
+}
+
+// 점수 높은 검출부터 같은 클래스의 아직 안 맞춘 라벨과 IoU 로 짝짓기
+static void score(const std::vector<Detection> &truth, std::vector<Detection> detections, float iouThreshold, Accuracy &accuracy)
+{
+    std::sort(detections.begin(), detections.end(), [](const Detection &a, const Detection &b) {
+        return a.confidence > b.confidence;
+    });
+    std::vector<bool> used(truth.size(), false);
+    for (const Detection &det : detections) {
+        int best = -1;
+        float bestIou = iouThreshold;
+        for (size_t i = 0; i < truth.size(); ++i) {
+            if (used[i] || truth[i].classId != det.classId)
+                continue;
+            const float inter = (det.box & truth[i].box).area();
+            const float iou = inter / (det.box.area() + truth[i].box.area() - inter);
+            if (iou >= bestIou) {
+                bestIou = iou;
+                best = int(i);
+            }
+        }
+        if (best >= 0) {
+            used[best] = true;
+            accuracy.matched++;
+        }
+    }
+    accuracy.truth += int(truth.size());
+    accuracy.detected += int(detections.size());
+}
+
+int runTileBench(const QStringList &args)
+{
+    QString model;
+    QString dataset;
+    QString split = "val";
+    QString jsonPath;
+    int limit = 100;
+    int iters = 20;
+    float iouThreshold = 0.5f;
+    TileSettings tiles;
+    for (int i = 0; i + 1 < args.size(); i += 2) {
+        if (args[i] == "--model") model = args[i + 1];
+        else if (args[i] == "--dataset") dataset = args[i + 1];
+        else if (args[i] == "--split") split = args[i + 1];
+        else if (args[i] == "--limit") limit = std::max(1, args[i + 1].toInt());
+        else if (args[i] == "--iters") iters = std::max(1, args[i + 1].toInt());
+        else if (args[i] == "--iou") iouThreshold = args[i + 1].toFloat();
+        else if (args[i] == "--tile-size") tiles.tileSize = args[i + 1].toInt();
+        else if (args[i] == "--overlap") tiles.overlap = args[i + 1].toDouble();
+        else if (args[i] == "--tile-batch") tiles.tilesPerForward = args[i + 1].toInt();
+        else if (args[i] == "--json") jsonPath = args[i + 1];
+    }
+
+    FILE *out = reportStream(jsonPath);
+    if (model.isEmpty()) {
+        std::fprintf(out, "tiles needs --model PATH\n");
+        return 1;
+    }
+    // GUI 와 같이 배치 2 로 시험해 고정 shape 모델이면 타일을 한 장씩 forward
+    bool dynamicShape = true;
+    QString error;
+    cv::dnn::Net net = ModelLoader::readModel(model, cv::dnn::DNN_BACKEND_OPENCV, cv::dnn::DNN_TARGET_CPU, 640, &error, &dynamicShape);
+    if (net.empty()) {
+        std::fprintf(out, "failed to load %s: %s\n", qPrintable(model), qPrintable(error));
+        return 1;
+    }
+    if (!dynamicShape && tiles.tilesPerForward != 1)
+        std::fprintf(out, "model has a fixed batch size, --tile-batch %d runs one tile per forward\n", tiles.tilesPerForward);
+
+    // 라벨이 있는 데이터셋이면 recall / precision 까지, 없으면 합성 1080p / 4K 프레임으로 처리량만
+    std::vector<SampleGroup> groups;
+    if (!dataset.isEmpty()) {
+        SampleGroup group;
+        group.resolution = split;
+        group.samples = readDataset(dataset, split, limit);
+        if (group.samples.empty()) {
+            std::fprintf(out, "no images in %s/images/%s\n", qPrintable(dataset), qPrintable(split));
+            return 1;
+        }
+        groups.push_back(group);
+    } else {
+        const struct {
+            const char *name;
+            cv::Size size;
+        } resolutions[] = {
+            { "1080p", cv::Size(1920, 1080) },
+            { "4k", cv::Size(3840, 2160) },
+        };
+        for (const auto &res : resolutions) {
+            SampleGroup group;
+            group.resolution = res.name;
+            Sample sample;
+            sample.image.create(res.size, CV_8UC3);
+            cv::randu(sample.image, cv::Scalar::all(0), cv::Scalar::all(255));
+            group.samples.push_back(sample);
+            groups.push_back(group);
+        }
+    }
+
+    BatchDetector detector;
+    detector.setModel(net, dynamicShape);
+    TiledDetector tiler(detector);
+
+    struct Mode {
+        const char *name;
+        bool tiled;
+        bool globalPass;
+    };
+    const Mode modes[] = {
+        { "single_pass", false, false },
+        { "tiled", true, false },
+        { "tiled_global", true, true },
+    };
+
+    std::fprintf(out, "single 640 pass vs %dpx tiles (overlap %.2f), %d iterations, %s frames\n",
+                tiles.tileSize, tiles.overlap, iters, dataset.isEmpty() ? "synthetic" : "labeled");
+
+    std::vector<StageStats> results;
+    std::vector<Detection> detections;
+    std::vector<std::vector<Detection>> single;
+    for (const Mode &mode : modes) {
+        TileSettings settings = tiles;
+        settings.enabled = mode.tiled;
+        settings.globalPass = mode.globalPass;
+        tiler.setSettings(settings);
+
+        // 지금 경로: 프레임 전체를 레터박스 한 장으로
+        auto run = [&](const cv::Mat &image) {
+            if (mode.tiled) {
+                tiler.detect(image, detections);
+                return;
+            }
+            const LetterboxInfo letterbox = detector.prepare(0, image);
+            detector.run(1, single);
+            const cv::Rect2f bounds(0.f, 0.f, float(image.cols), float(image.rows));
+            detections.clear();
+            for (Detection det : single[0]) {
+                det.box = letterbox.toSource(det.box) & bounds;
+                detections.push_back(det);
+            }
+        };
+
+        for (const SampleGroup &group : groups) {
+            const std::vector<Sample> &samples = group.samples;
+            run(samples[0].image);  // 워밍업
+
+            // 데이터셋은 모든 장이 최소 한 번은 재지도록 돌아가며
+            const int count = std::max(iters, int(samples.size()));
+            const std::vector<double> times = measure(count, [&](int i) {
+                run(samples[size_t(i) % samples.size()].image);
+            });
+            results.push_back(summarize(mode.name, group.resolution, times));
+            printStats(results.back(), out);
+
+            // 매칭 비용이 추론 시간에 섞이지 않게 채점은 측정 밖에서 한 번 더 돌린다
+            Accuracy accuracy;
+            for (const Sample &sample : samples) {
+                if (sample.truth.empty())
+                    continue;
+                run(sample.image);
+                score(sample.truth, detections, iouThreshold, accuracy);
+            }
+            if (accuracy.truth > 0) {
+                results.back().recall = double(accuracy.matched) / accuracy.truth;
+                results.back().precision = accuracy.detected ? double(accuracy.matched) / accuracy.detected : 0.0;
+                std::fprintf(out, "    recall %.3f  precision %.3f  (%d / %d labels, %d detections, IoU %.2f)\n",
+                             results.back().recall, results.back().precision,
+                             accuracy.matched, accuracy.truth, accuracy.detected, iouThreshold);
+            }
+        }
+    }
+
+    if (!jsonPath.isEmpty() && !writeJson(jsonPath, results)) {
+        std::fprintf(out, "failed to write %s\n", qPrintable(jsonPath));
+        return 1;
+    }
+    return 0;
+}
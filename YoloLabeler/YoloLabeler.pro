@@ -0,0 +1,32 @@
+QT       += core
+QT       -= gui
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../YoloWebCam
+INCLUDEPATH += /usr/local/include/opencv4
+LIBS += -L/usr/local/lib \
+    -lopencv_core \
+    -lopencv_imgproc \
+    -lopencv_imgcodecs \
+    -lopencv_dnn
+
+SOURCES += \
+    autolabeler.cpp \
+    main.cpp \
+    ../YoloWebCam/autotuner.cpp \
+    ../YoloWebCam/batchdetector.cpp \
+    ../YoloWebCam/modelloader.cpp \
+    ../YoloWebCam/preprocessor.cpp \
+    ../YoloWebCam/yolodecoder.cpp
+
+HEADERS += \
+    autolabeler.h \
+    ../YoloWebCam/autotuner.h \
+    ../YoloWebCam/batchdetector.h \
+    ../YoloWebCam/boundedqueue.h \
+    ../YoloWebCam/modelloader.h \
+    ../YoloWebCam/preprocessor.h \
+    ../YoloWebCam/yolodecoder.h \
+    ../YoloWebCam/yololabel.h
@@ -0,0 +1,221 @@
+// autolabeler.cpp
+#include "autolabeler.h"
+#include "batchdetector.h"
+#include "modelloader.h"
+#include "yololabel.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QThread>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <opencv2/dnn.hpp>
+#include <opencv2/imgcodecs.hpp>
+
+AutoLabeler::AutoLabeler(const LabelerSettings &labelerSettings)
+    : settings(labelerSettings)
+    , skipped(0)
+    , dynamicShape(true)
+    , prepared(std::max(2, labelerSettings.workers * std::max(2, labelerSettings.batchSize)))
+    , nextJob(0)
+    , loadersRunning(0)
+    , done(0)
+    , failed(0)
+    , boxes(0)
+{
+    if (settings.splits.isEmpty())
+        settings.splits << "train" << "val";
+}
+
+void AutoLabeler::collectJobs()
+{
+    // refreshFileList 와 같은 필터 / 폴더 구조
+    QStringList filters;
+    filters << "*.png" << "*.jpg" << "*.jpeg" << "*.bmp";
+
+    for (const QString &split : settings.splits) {
+        QDir imagesDir(settings.root + "/images/" + split);
+        if (!imagesDir.exists()) {
+            std::printf("skip %s: no images/%s\n", qPrintable(split), qPrintable(split));
+            continue;
+        }
+
+        const QString labelsPath = settings.root + "/labels/" + split + "/";
+        QDir().mkpath(labelsPath);
+
+        const QFileInfoList entries = imagesDir.entryInfoList(filters, QDir::Files | QDir::NoDotAndDotDot, QDir::Name);
+        for (const QFileInfo &entry : entries) {
+            Job job;
+            job.imagePath = entry.absoluteFilePath();
+            job.labelPath = labelsPath + entry.completeBaseName() + ".txt";
+
+            if (settings.skipExisting && QFile::exists(job.labelPath)) {
+                skipped++;
+                continue;
+            }
+            jobs.push_back(job);
+        }
+    }
+}
+
+void AutoLabeler::loaderLoop()
+{
+    Preprocessor preprocessor(settings.inputSize);
+    const int sizes[] = { 1, 3, settings.inputSize, settings.inputSize };
+
+    for (int index = nextJob++; index < jobs.size(); index = nextJob++) {
+        cv::Mat image = cv::imread(jobs[index].imagePath.toStdString(), cv::IMREAD_COLOR);
+        if (image.empty()) {
+            std::printf("failed to read %s\n", qPrintable(jobs[index].imagePath));
+            failed++;
+            done++;
+            continue;
+        }
+
+        // 큐에 들어가는 항목마다 자기 blob 을 가진다
+        Prepared item;
+        item.job = index;
+        item.size = image.size();
+        item.blob.create(4, sizes, CV_32F);
+        item.letterbox = preprocessor.process(image, item.blob.ptr<float>());
+
+        if (!prepared.push(item))
+            break;
+    }
+
+    // 마지막 로더가 끝나면 큐를 닫아 추론 스레드가 종료되게 한다
+    if (--loadersRunning == 0)
+        prepared.close();
+}
+
+void AutoLabeler::inferLoop()
+{
+    cv::dnn::Net net = cv::dnn::readNetFromONNX(settings.model.toStdString());
+    net.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+    net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+
+    BatchDetector detector(settings.inputSize);
+    detector.setModel(net, dynamicShape);
+    detector.decoder().setConfThreshold(settings.confThreshold);
+    detector.decoder().setNmsThreshold(settings.nmsThreshold);
+
+    const int batchSize = std::max(1, settings.batchSize);
+    const size_t blobBytes = size_t(3) * settings.inputSize * settings.inputSize * sizeof(float);
+    detector.reserve(batchSize);
+
+    std::vector<Prepared> batch;
+    std::vector<std::vector<Detection>> results;
+    while (prepared.popBatch(batch, batchSize, settings.batchTimeoutMs) > 0) {
+        const int count = int(batch.size());
+        for (int i = 0; i < count; ++i)
+            std::memcpy(detector.slot(i), batch[i].blob.ptr<float>(), blobBytes);
+        try {
+            detector.run(count, results);
+        } catch (const cv::Exception &e) {
+            // 스레드 밖으로 예외가 나가면 프로세스가 죽는다. 이 배치만 실패로 세고 진행률은 계속 올린다
+            std::printf("inference failed for %d images: %s\n", count, e.what());
+            failed += count;
+            done += count;
+            continue;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            const Prepared &item = batch[i];
+
+            // 네트워크 입력 좌표 → 원본 픽셀 → 0~1 정규화 (onBoxCreated 와 같은 포맷)
+            const float imgW = float(item.size.width);
+            const float imgH = float(item.size.height);
+            const cv::Rect2f bounds(0.f, 0.f, imgW, imgH);
+            QStringList lines;
+            for (const Detection &det : results[i]) {
+                const cv::Rect2f box = item.letterbox.toSource(det.box) & bounds;
+                if (box.width <= 0.f || box.height <= 0.f)
+                    continue;
+                lines << formatYoloLabel(det.classId,
+                                         (box.x + box.width / 2.0) / imgW,
+                                         (box.y + box.height / 2.0) / imgH,
+                                         box.width / imgW,
+                                         box.height / imgH);
+            }
+
+            if (writeLabels(jobs[item.job], lines))
+                boxes += lines.size();
+            else
+                failed++;
+            done++;
+        }
+    }
+}
+
+bool AutoLabeler::writeLabels(const Job &job, const QStringList &lines)
+{
+    // 임시 파일에 쓰고 rename → 중간에 끊겨도 반쯤 쓴 라벨 파일이 남지 않는다
+    QSaveFile file(job.labelPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        std::printf("failed to write %s\n", qPrintable(job.labelPath));
+        return false;
+    }
+    for (const QString &line : lines)
+        file.write(line.toUtf8() + "\n");
+    return file.commit();
+}
+
+int AutoLabeler::run()
+{
+    // 스레드를 띄우기 전에 모델이 읽히는지 먼저 확인 (추론 스레드가 없으면 로더가 영원히 대기)
+    // + 배치 2 로 한 번 돌려 고정 shape 모델이면 배치를 1 로 줄인다
+    QString error;
+    if (!QFile::exists(settings.model)
+        || ModelLoader::readModel(settings.model, cv::dnn::DNN_BACKEND_OPENCV, cv::dnn::DNN_TARGET_CPU,
+                                  settings.inputSize, &error, &dynamicShape).empty()) {
+        std::printf("failed to load model: %s %s\n", qPrintable(settings.model), qPrintable(error));
+        return 1;
+    }
+    if (!dynamicShape && settings.batchSize > 1) {
+        std::printf("model has a fixed batch size, --batch %d ignored\n", settings.batchSize);
+        settings.batchSize = 1;
+    }
+
+    collectJobs();
+    std::printf("%d images to label, %d skipped (existing labels)\n", jobs.size(), skipped);
+    if (jobs.isEmpty())
+        return 0;
+
+    if (settings.threads > 0)
+        cv::setNumThreads(settings.threads);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const int loaderCount = std::max(1, settings.loaders);
+    const int workerCount = std::max(1, settings.workers);
+    loadersRunning = loaderCount;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < loaderCount; ++i)
+        threads.emplace_back(&AutoLabeler::loaderLoop, this);
+    for (int i = 0; i < workerCount; ++i)
+        threads.emplace_back(&AutoLabeler::inferLoop, this);
+
+    // 진행 상황 / 처리 속도 출력
+    while (done < jobs.size()) {
+        QThread::msleep(2000);
+        const double seconds = timer.elapsed() / 1000.0;
+        std::printf("%d / %d  %.1f images/sec\n", done.load(), jobs.size(), done / std::max(seconds, 1e-3));
+        std::fflush(stdout);
+    }
+
+    for (std::thread &thread : threads)
+        thread.join();
+
+    const double seconds = timer.elapsed() / 1000.0;
+    std::printf("done: %d images, %lld boxes, %d failed, %.1f s, %.1f images/sec\n",
+                jobs.size(), boxes.load(), failed.load(), seconds, jobs.size() / std::max(seconds, 1e-3));
+    return failed > 0 ? 2 : 0;
+}
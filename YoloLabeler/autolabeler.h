@@ -0,0 +1,63 @@
+// autolabeler.h
+#pragma once
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <atomic>
+#include <opencv2/core.hpp>
+#include "boundedqueue.h"
+#include "preprocessor.h"
+
+struct LabelerSettings {
+    QString root;                   // images/<split>, labels/<split> 를 가진 데이터셋 루트
+    QString model;                  // ONNX 모델 경로
+    QStringList splits;             // 기본: train, val
+    bool skipExisting = false;      // 라벨 파일이 이미 있는 이미지는 건너뜀
+    float confThreshold = 0.25f;
+    float nmsThreshold = 0.45f;
+    int loaders = 2;                // 디코딩 + 전처리 스레드
+    int workers = 2;                // 추론 스레드 (각자 Net 인스턴스)
+    int threads = 0;                // cv::setNumThreads (0 이면 기본값)
+    int inputSize = 640;
+    int batchSize = 1;              // 추론 스레드가 forward 한 번에 넣는 이미지 수
+    int batchTimeoutMs = 20;        // 배치가 덜 차도 이만큼 기다리면 보낸다
+};
+
+// 헤드리스 자동 라벨링: 디코딩/전처리 → 추론 → labels/<split>/<basename>.txt 기록
+class AutoLabeler
+{
+public:
+    explicit AutoLabeler(const LabelerSettings &settings);
+
+    int run();
+
+private:
+    struct Job {
+        QString imagePath;
+        QString labelPath;
+    };
+
+    struct Prepared {
+        int job = -1;
+        cv::Mat blob;               // (1, 3, inputSize, inputSize)
+        LetterboxInfo letterbox;
+        cv::Size size;              // 원본 이미지 크기
+    };
+
+    void collectJobs();
+    void loaderLoop();
+    void inferLoop();
+    bool writeLabels(const Job &job, const QStringList &lines);
+
+    LabelerSettings settings;
+    QVector<Job> jobs;
+    int skipped;
+    bool dynamicShape;              // run() 에서 확인, 고정 shape 모델이면 배치 1
+
+    BoundedQueue<Prepared> prepared;
+    std::atomic<int> nextJob;
+    std::atomic<int> loadersRunning;
+    std::atomic<int> done;
+    std::atomic<int> failed;
+    std::atomic<long long> boxes;
+};
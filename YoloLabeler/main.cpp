@@ -0,0 +1,48 @@
+// main.cpp
+#include "autolabeler.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("YoloLabeler");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Pre-label a YOLO dataset (images/<split> → labels/<split>) with an ONNX model.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("root", "Dataset root containing images/train and images/val.");
+    QCommandLineOption modelOption("model", "ONNX model path.", "path");
+    QCommandLineOption splitsOption("splits", "Comma separated splits.", "list", "train,val");
+    QCommandLineOption skipOption("skip-existing", "Skip images that already have a label file.");
+    QCommandLineOption confOption("conf", "Confidence threshold.", "value", "0.25");
+    QCommandLineOption iouOption("iou", "NMS IoU threshold.", "value", "0.45");
+    QCommandLineOption loadersOption("loaders", "Decode/preprocess threads.", "count", "2");
+    QCommandLineOption workersOption("workers", "Inference threads.", "count", "2");
+    QCommandLineOption threadsOption("threads", "OpenCV threads (0 = default).", "count", "0");
+    QCommandLineOption batchOption("batch", "Images per forward pass (dynamic-batch model).", "count", "1");
+    QCommandLineOption batchTimeoutOption("batch-timeout", "Max wait for a batch to fill.", "ms", "20");
+    parser.addOptions({ modelOption, splitsOption, skipOption, confOption, iouOption,
+                        loadersOption, workersOption, threadsOption, batchOption, batchTimeoutOption });
+    parser.process(app);
+
+    if (parser.positionalArguments().size() != 1 || !parser.isSet(modelOption))
+        parser.showHelp(1);
+
+    LabelerSettings settings;
+    settings.root = parser.positionalArguments().first();
+    settings.model = parser.value(modelOption);
+    settings.splits = parser.value(splitsOption).split(',', QString::SkipEmptyParts);
+    settings.skipExisting = parser.isSet(skipOption);
+    settings.confThreshold = parser.value(confOption).toFloat();
+    settings.nmsThreshold = parser.value(iouOption).toFloat();
+    settings.loaders = parser.value(loadersOption).toInt();
+    settings.workers = parser.value(workersOption).toInt();
+    settings.threads = parser.value(threadsOption).toInt();
+    settings.batchSize = parser.value(batchOption).toInt();
+    settings.batchTimeoutMs = parser.value(batchTimeoutOption).toInt();
+
+    AutoLabeler labeler(settings);
+    return labeler.run();
+}
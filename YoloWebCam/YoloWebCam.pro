@@ -11,23 +11,71 @@ LIBS += -L/usr/local/lib \
     -lopencv_highgui \
     -lopencv_imgcodecs \
     -lopencv_videoio \
-    -lopencv_dnn
+    -lopencv_dnn \
+    -lopencv_video
+
+# 핫패스 추적 계측 (qmake CONFIG+=trace, 실행 중 F12 로 Chrome trace JSON 저장)
+trace: DEFINES += YOLO_TRACE
 
 # You can make your code fail to compile if it uses deprecated APIs.
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    annotationstore.cpp \
+    autotuner.cpp \
+    batchdetector.cpp \
+    captureencoder.cpp \
+    datasetmodel.cpp \
+    displayscaler.cpp \
+    filesource.cpp \
+    framepool.cpp \
+    framesource.cpp \
+    imagecache.cpp \
+    inferencepool.cpp \
     inferenceworker.cpp \
     main.cpp \
     mainwindow.cpp \
-    webcamworker.cpp
+    modelloader.cpp \
+    objecttracker.cpp \
+    pipelinestats.cpp \
+    preprocessor.cpp \
+    resolutioncontroller.cpp \
+    streamrecorder.cpp \
+    tileddetector.cpp \
+    tracing.cpp \
+    videogrid.cpp \
+    webcamworker.cpp \
+    yolodecoder.cpp
 
 HEADERS += \
+    annotationstore.h \
+    autotuner.h \
+    batchdetector.h \
+    captureencoder.h \
+    datasetmodel.h \
+    displayscaler.h \
+    filesource.h \
+    framemailbox.h \
+    framepool.h \
+    framesource.h \
+    imagecache.h \
     imagelabel.h \
+    inferencepool.h \
     inferenceworker.h \
     mainwindow.h \
-    webcamworker.h
+    modelloader.h \
+    objecttracker.h \
+    pipelinestats.h \
+    preprocessor.h \
+    resolutioncontroller.h \
+    streamrecorder.h \
+    tileddetector.h \
+    tracing.h \
+    videogrid.h \
+    webcamworker.h \
+    yolodecoder.h \
+    yololabel.h
 
 FORMS += \
     mainwindow.ui
@@ -0,0 +1,151 @@
+// annotationstore.cpp
+#include "annotationstore.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QUndoCommand>
+
+namespace {
+
+const int kFlushDelayMs = 500;       // 연속 편집을 모으는 시간
+const int kRetryIntervalMs = 2000;   // 저장 실패 후 재시도 간격 (디스크가 꽉 찼을 때 계속 두드리지 않게)
+
+} // namespace
+
+void LabelWriter::write(const QString &labelPath, const QVector<YoloLabel> &labels)
+{
+    // 박스가 하나도 없으면 파일을 지워서 "라벨 없음" 상태로 되돌린다
+    if (labels.isEmpty()) {
+        emit written(labelPath, !QFile::exists(labelPath) || QFile::remove(labelPath));
+        return;
+    }
+
+    QDir().mkpath(QFileInfo(labelPath).absolutePath());
+
+    // 🔥 임시 파일에 다 쓰고 commit 에서 rename (원자적 교체)
+    QSaveFile file(labelPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        emit written(labelPath, false);
+        return;
+    }
+    QTextStream out(&file);
+    for (const YoloLabel &label : labels)
+        out << formatYoloLabel(label) << "\n";
+    out.flush();
+    emit written(labelPath, file.commit());
+}
+
+// 라벨 파일 하나의 박스 목록을 before → after 로 바꾸는 편집
+class SetLabelsCommand : public QUndoCommand
+{
+public:
+    SetLabelsCommand(AnnotationStore *store, const QString &labelPath,
+                     const QVector<YoloLabel> &before, const QVector<YoloLabel> &after, const QString &text)
+        : QUndoCommand(text), store(store), labelPath(labelPath), before(before), after(after)
+    {
+    }
+
+    void undo() override { store->apply(labelPath, before); }
+    void redo() override { store->apply(labelPath, after); }
+
+private:
+    AnnotationStore *store;
+    QString labelPath;
+    QVector<YoloLabel> before;
+    QVector<YoloLabel> after;
+};
+
+AnnotationStore::AnnotationStore(QObject *parent)
+    : QObject(parent)
+{
+    qRegisterMetaType<QVector<YoloLabel>>("QVector<YoloLabel>");
+
+    writer = new LabelWriter();
+    writer->moveToThread(&writeThread);
+    connect(&writeThread, &QThread::finished, writer, &QObject::deleteLater);
+    connect(this, &AnnotationStore::requestWrite, writer, &LabelWriter::write);
+    connect(writer, &LabelWriter::written, this, &AnnotationStore::onWritten);
+    writeThread.start();
+
+    flushTimer.setSingleShot(true);
+    connect(&flushTimer, &QTimer::timeout, this, &AnnotationStore::flush);
+}
+
+AnnotationStore::~AnnotationStore()
+{
+    flush();
+    waitForWriter();
+    writeThread.quit();
+    writeThread.wait();
+}
+
+void AnnotationStore::seed(const QString &labelPath, const QVector<YoloLabel> &labels)
+{
+    if (!annotations.contains(labelPath))
+        annotations.insert(labelPath, labels);
+}
+
+void AnnotationStore::addLabel(const QString &labelPath, const YoloLabel &label)
+{
+    // 표시하면서 seed 되지 않은 파일만 여기서 한 번 읽는다
+    if (!annotations.contains(labelPath))
+        annotations.insert(labelPath, readYoloLabels(labelPath));
+
+    QVector<YoloLabel> after = annotations.value(labelPath);
+    after.push_back(label);
+    setLabels(labelPath, after, QStringLiteral("Add box"));
+}
+
+void AnnotationStore::setLabels(const QString &labelPath, const QVector<YoloLabel> &labels, const QString &text)
+{
+    // push 가 redo() 를 호출해서 바로 적용된다
+    history.push(new SetLabelsCommand(this, labelPath, annotations.value(labelPath), labels, text));
+}
+
+void AnnotationStore::apply(const QString &labelPath, const QVector<YoloLabel> &labels)
+{
+    annotations.insert(labelPath, labels);
+    dirty.insert(labelPath);
+    flushTimer.start(kFlushDelayMs);
+    emit labelsChanged(labelPath);
+}
+
+void AnnotationStore::discard(const QString &labelPath)
+{
+    annotations.remove(labelPath);
+    dirty.remove(labelPath);
+    history.clear();   // 지워진 파일을 undo 로 되살리지 않게
+    waitForWriter();
+}
+
+void AnnotationStore::flush()
+{
+    flushTimer.stop();
+    for (const QString &labelPath : dirty)
+        emit requestWrite(labelPath, annotations.value(labelPath));
+    dirty.clear();
+}
+
+void AnnotationStore::waitForWriter()
+{
+    // 쓰기 스레드 이벤트 큐의 앞선 요청이 모두 끝날 때까지
+    QMetaObject::invokeMethod(writer, []() {}, Qt::BlockingQueuedConnection);
+}
+
+void AnnotationStore::onWritten(const QString &labelPath, bool ok)
+{
+    if (ok)
+        return;
+
+    // 다른 편집이 없어도 잠시 뒤 다시 시도
+    qWarning("Failed to write label file: %s", qPrintable(labelPath));
+    if (annotations.contains(labelPath)) {
+        dirty.insert(labelPath);
+        if (!flushTimer.isActive())
+            flushTimer.start(kRetryIntervalMs);
+    }
+    emit writeFailed(labelPath);
+}
@@ -0,0 +1,78 @@
+// annotationstore.h
+#pragma once
+#include <QHash>
+#include <QMetaType>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QThread>
+#include <QTimer>
+#include <QUndoStack>
+#include <QVector>
+#include "yololabel.h"
+
+Q_DECLARE_METATYPE(QVector<YoloLabel>)
+
+// 라벨 파일 쓰기 워커 (전용 스레드).
+// QSaveFile 로 임시 파일에 다 쓴 뒤 rename 하므로 중간에 죽어도 반쯤 쓰인 라벨 파일이 남지 않는다
+class LabelWriter : public QObject
+{
+    Q_OBJECT
+
+public slots:
+    void write(const QString &labelPath, const QVector<YoloLabel> &labels);
+
+signals:
+    void written(const QString &labelPath, bool ok);
+};
+
+// 데이터셋 라벨의 메모리 사본 (라벨 파일 경로 → 박스 목록).
+// 편집은 메모리에만 바로 반영하고 (undo / redo 가능), 파일에는 잠깐 모았다가 쓰기 스레드에서 한 번에 저장한다.
+// GUI 스레드에서만 사용
+class AnnotationStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AnnotationStore(QObject *parent = nullptr);
+    ~AnnotationStore();   // 남은 변경을 모두 저장하고 끝낸다
+
+    bool contains(const QString &labelPath) const { return annotations.contains(labelPath); }
+    QVector<YoloLabel> labels(const QString &labelPath) const { return annotations.value(labelPath); }
+
+    // 디스크에서 읽어 온 라벨로 처음 채움 (이미 알고 있는 파일이면 메모리 쪽이 최신이므로 무시)
+    void seed(const QString &labelPath, const QVector<YoloLabel> &labels);
+
+    // undo 가능한 편집
+    void addLabel(const QString &labelPath, const YoloLabel &label);
+    void setLabels(const QString &labelPath, const QVector<YoloLabel> &labels, const QString &text);
+
+    // 이미지 / 라벨 파일을 지우기 직전: 메모리 사본, 대기 중인 저장, undo 기록을 버리고 진행 중인 쓰기를 기다린다
+    void discard(const QString &labelPath);
+
+    // 모아 둔 변경을 지금 쓰기 스레드로 보냄
+    void flush();
+
+    QUndoStack *undoStack() { return &history; }
+
+signals:
+    void labelsChanged(const QString &labelPath);
+    void writeFailed(const QString &labelPath);
+    void requestWrite(const QString &labelPath, const QVector<YoloLabel> &labels);
+
+private slots:
+    void onWritten(const QString &labelPath, bool ok);
+
+private:
+    friend class SetLabelsCommand;
+    void apply(const QString &labelPath, const QVector<YoloLabel> &labels);
+    void waitForWriter();
+
+    QHash<QString, QVector<YoloLabel>> annotations;
+    QSet<QString> dirty;           // 메모리와 파일이 다른 라벨
+    QTimer flushTimer;             // 연속 편집을 모아서 한 번만 저장
+    QUndoStack history;
+
+    QThread writeThread;
+    LabelWriter *writer;
+};
@@ -0,0 +1,203 @@
+// autotuner.cpp
+#include "autotuner.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QSettings>
+#include <QStringList>
+#include <QSysInfo>
+#include <QTextStream>
+#include <QThread>
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <vector>
+#include <opencv2/core.hpp>
+#include <opencv2/dnn.hpp>
+
+namespace {
+
+QString cpuModel()
+{
+    // 리눅스는 /proc/cpuinfo 의 model name, 없으면 아키텍처 이름만
+    QFile file("/proc/cpuinfo");
+    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        QTextStream in(&file);
+        while (!in.atEnd()) {
+            const QString line = in.readLine();
+            if (line.startsWith("model name"))
+                return line.section(':', 1).trimmed();
+        }
+    }
+    return QSysInfo::currentCpuArchitecture();
+}
+
+QString backendName(int backend)
+{
+    switch (backend) {
+    case cv::dnn::DNN_BACKEND_OPENCV: return "opencv";
+    case cv::dnn::DNN_BACKEND_INFERENCE_ENGINE: return "openvino";
+    case cv::dnn::DNN_BACKEND_CUDA: return "cuda";
+    default: return QString::number(backend);
+    }
+}
+
+QString targetName(int target)
+{
+    switch (target) {
+    case cv::dnn::DNN_TARGET_CPU: return "cpu";
+    case cv::dnn::DNN_TARGET_OPENCL: return "opencl";
+    case cv::dnn::DNN_TARGET_OPENCL_FP16: return "opencl-fp16";
+    case cv::dnn::DNN_TARGET_CUDA: return "cuda";
+    case cv::dnn::DNN_TARGET_CUDA_FP16: return "cuda-fp16";
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 8)
+    case cv::dnn::DNN_TARGET_CPU_FP16: return "cpu-fp16";
+#endif
+    default: return QString::number(target);
+    }
+}
+
+bool isCpuTarget(int target)
+{
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 8)
+    if (target == cv::dnn::DNN_TARGET_CPU_FP16)
+        return true;
+#endif
+    return target == cv::dnn::DNN_TARGET_CPU;
+}
+
+// 워밍업 2회 후 중앙값 (ms). 실패하면 음수
+double measure(const QString &modelPath, int backend, int target, int inputSize, int iterations)
+{
+    try {
+        cv::dnn::Net net = cv::dnn::readNetFromONNX(modelPath.toStdString());
+        if (net.empty())
+            return -1;
+        net.setPreferableBackend(backend);
+        net.setPreferableTarget(target);
+        const std::vector<cv::String> outputNames = net.getUnconnectedOutLayersNames();
+
+        const int sizes[] = { 1, 3, inputSize, inputSize };
+        cv::Mat blob(4, sizes, CV_32F);
+        cv::randu(blob, 0.f, 1.f);
+
+        std::vector<cv::Mat> outputs;
+        for (int i = 0; i < 2; ++i) {
+            net.setInput(blob);
+            net.forward(outputs, outputNames);
+        }
+
+        std::vector<double> times;
+        for (int i = 0; i < iterations; ++i) {
+            auto start = std::chrono::high_resolution_clock::now();
+            net.setInput(blob);
+            net.forward(outputs, outputNames);
+            auto end = std::chrono::high_resolution_clock::now();
+            times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    } catch (const cv::Exception &) {
+        return -1;   // 이 빌드 / 장치에서 안 되는 조합
+    }
+}
+
+} // namespace
+
+QString Autotuner::cacheKey(const QString &modelPath, int workers)
+{
+    QCryptographicHash model(QCryptographicHash::Sha1);
+    QFile file(modelPath);
+    if (!file.open(QIODevice::ReadOnly) || !model.addData(&file))
+        return QString();
+
+    QCryptographicHash key(QCryptographicHash::Sha1);
+    key.addData(model.result());
+    key.addData(cpuModel().toUtf8());
+    key.addData(QByteArray(cv::getVersionString().c_str()));
+    key.addData(QByteArray::number(workers));
+    return QString::fromLatin1(key.result().toHex());
+}
+
+bool Autotuner::cached(const QString &key, TuneResult &result)
+{
+    if (key.isEmpty())
+        return false;
+
+    // "backend,target,threads,inputSize,ms"
+    const QStringList parts = QSettings("YoloWebCam", "YoloWebCam").value("autotune/" + key).toString().split(',');
+    if (parts.size() != 5)
+        return false;
+
+    result.backend = parts[0].toInt();
+    result.target = parts[1].toInt();
+    result.threads = parts[2].toInt();
+    result.inputSize = parts[3].toInt();
+    result.ms = parts[4].toDouble();
+    return result.isValid();
+}
+
+void Autotuner::store(const QString &key, const TuneResult &result)
+{
+    if (key.isEmpty() || !result.isValid())
+        return;
+
+    QSettings("YoloWebCam", "YoloWebCam").setValue("autotune/" + key, QString("%1,%2,%3,%4,%5")
+        .arg(result.backend).arg(result.target).arg(result.threads).arg(result.inputSize).arg(result.ms, 0, 'f', 2));
+}
+
+TuneResult Autotuner::tune(const QString &modelPath, int workers, const QVector<int> &inputSizes)
+{
+    // 후보: 이 빌드에서 쓸 수 있는 모든 백엔드 / 타깃 + CPU FP16
+    std::vector<std::pair<cv::dnn::Backend, cv::dnn::Target>> pairs = cv::dnn::getAvailableBackends();
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 8)
+    const std::pair<cv::dnn::Backend, cv::dnn::Target> fp16(cv::dnn::DNN_BACKEND_OPENCV, cv::dnn::DNN_TARGET_CPU_FP16);
+    if (std::find(pairs.begin(), pairs.end(), fp16) == pairs.end())
+        pairs.push_back(fp16);
+#endif
+
+    // 워커마다 코어를 나눠 쓰므로 워커 한 개 몫의 스레드 수부터 절반씩
+    const int perWorker = std::max(1, QThread::idealThreadCount() / std::max(1, workers));
+    std::vector<int> threadCounts;
+    for (int threads = perWorker; threads >= 1; threads /= 2) {
+        threadCounts.push_back(threads);
+        if (threadCounts.size() == 3)
+            break;
+    }
+
+    const int previousThreads = cv::getNumThreads();
+    TuneResult best;
+    for (const auto &pair : pairs) {
+        for (int threads : threadCounts) {
+            // GPU / OpenCL 타깃은 CPU 스레드 수와 상관없으므로 한 번만
+            if (!isCpuTarget(pair.second) && threads != perWorker)
+                continue;
+
+            cv::setNumThreads(threads);
+            for (int inputSize : inputSizes) {
+                TuneResult candidate;
+                candidate.backend = pair.first;
+                candidate.target = pair.second;
+                candidate.threads = threads;
+                candidate.inputSize = inputSize;
+                candidate.ms = measure(modelPath, pair.first, pair.second, inputSize, 10);
+                if (candidate.ms < 0)
+                    continue;
+
+                qInfo("autotune  %-32s %.2f ms", qPrintable(describe(candidate)), candidate.ms);
+                if (!best.isValid() || candidate.ms < best.ms)
+                    best = candidate;
+            }
+        }
+    }
+    cv::setNumThreads(previousThreads);
+    return best;
+}
+
+QString Autotuner::describe(const TuneResult &result)
+{
+    return QString("%1/%2 threads=%3 input=%4")
+        .arg(backendName(result.backend), targetName(result.target))
+        .arg(result.threads)
+        .arg(result.inputSize);
+}
@@ -0,0 +1,32 @@
+// autotuner.h
+#pragma once
+#include <QString>
+#include <QVector>
+
+// 한 가지 실행 설정 (백엔드 / 타깃 / 워커당 OpenCV 스레드 / 입력 크기) 과 측정한 forward 시간
+struct TuneResult {
+    int backend = -1;
+    int target = -1;
+    int threads = 0;
+    int inputSize = 640;
+    double ms = 0;
+
+    bool isValid() const { return backend >= 0 && target >= 0; }
+};
+
+// 시작할 때 모델에 맞는 가장 빠른 실행 설정을 찾는다.
+// 사용 가능한 백엔드 / 타깃 조합 × 스레드 수 × 입력 크기를 실제 모델로 forward 해 보고,
+// 결과는 (모델 파일 해시, CPU 모델, OpenCV 버전, 워커 수) 를 키로 QSettings 에 저장해 두었다가 다음부터 바로 쓴다
+class Autotuner
+{
+public:
+    static QString cacheKey(const QString &modelPath, int workers);
+    static bool cached(const QString &key, TuneResult &result);
+    static void store(const QString &key, const TuneResult &result);
+
+    // 느리다 (조합마다 Net 을 새로 만들고 여러 번 forward). 로더 스레드에서만 호출.
+    // cv::setNumThreads 를 바꿨다가 되돌리므로 추론 워커가 forward 중이 아닐 때만 부른다
+    static TuneResult tune(const QString &modelPath, int workers, const QVector<int> &inputSizes);
+
+    static QString describe(const TuneResult &result);
+};
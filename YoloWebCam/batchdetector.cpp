@@ -0,0 +1,82 @@
+// batchdetector.cpp
+#include "batchdetector.h"
+#include <cstring>
+
+BatchDetector::BatchDetector(int inputSize)
+    : dynamic(true), preprocessor(inputSize), capacity(0)
+{
+    reserve(1);
+}
+
+void BatchDetector::setModel(cv::dnn::Net model, bool dynamicShape)
+{
+    net = model;
+    dynamic = dynamicShape;
+    outputNames = net.empty() ? std::vector<cv::String>() : net.getUnconnectedOutLayersNames();
+}
+
+void BatchDetector::setInputSize(int size)
+{
+    if (size == preprocessor.inputSize())
+        return;
+
+    preprocessor.setInputSize(size);
+    const int keep = capacity;
+    capacity = 0;
+    reserve(keep);
+}
+
+void BatchDetector::reserve(int count)
+{
+    if (count <= capacity)
+        return;
+
+    const int size = preprocessor.inputSize();
+    const int sizes[] = { count, 3, size, size };
+    cv::Mat grown(4, sizes, CV_32F);
+
+    // 이미 채워진 슬롯은 보존
+    if (!batchBlob.empty() && batchBlob.size[2] == size)
+        std::memcpy(grown.data, batchBlob.data, batchBlob.total() * batchBlob.elemSize());
+
+    batchBlob = grown;
+    capacity = count;
+}
+
+float *BatchDetector::slot(int index)
+{
+    const size_t slotSize = size_t(3) * preprocessor.inputSize() * preprocessor.inputSize();
+    return batchBlob.ptr<float>() + slotSize * index;
+}
+
+LetterboxInfo BatchDetector::prepare(int index, const cv::Mat &image)
+{
+    reserve(index + 1);
+    return preprocessor.process(image, slot(index));
+}
+
+void BatchDetector::run(int count, std::vector<std::vector<Detection>> &results)
+{
+    results.resize(count);
+    for (std::vector<Detection> &detections : results)
+        detections.clear();
+    if (net.empty() || count <= 0)
+        return;
+
+    // 앞의 count 장만 보는 헤더 (복사 없음)
+    const int size = preprocessor.inputSize();
+    const int sizes[] = { count, 3, size, size };
+    net.setInput(cv::Mat(4, sizes, CV_32F, batchBlob.data));
+    net.forward(outputs, outputNames);
+
+    // 출력 (count, 4+nc, anchors): 장마다 연속된 (4+nc) x anchors 블록
+    if (outputs.empty() || outputs[0].dims != 3 || outputs[0].type() != CV_32F
+        || outputs[0].size[0] < count || !outputs[0].isContinuous())
+        return;
+
+    const cv::Mat &output = outputs[0];
+    const int channels = output.size[1];
+    const int anchors = output.size[2];
+    for (int i = 0; i < count; ++i)
+        yoloDecoder.decode(output.ptr<float>() + size_t(i) * channels * anchors, channels, anchors, results[i]);
+}
@@ -0,0 +1,48 @@
+// batchdetector.h
+#pragma once
+#include <vector>
+#include <opencv2/core.hpp>
+#include <opencv2/dnn.hpp>
+#include "preprocessor.h"
+#include "yolodecoder.h"
+
+// 여러 장을 (N, 3, S, S) 한 배치로 forward 한 번에 추론하고 장별로 디코딩한다.
+// best.onnx 는 dynamic=True 로 export 되어 배치 차원이 가변이다 (고정 shape 모델이면 setModel 에 알려 1장씩만 쓴다).
+class BatchDetector
+{
+public:
+    explicit BatchDetector(int inputSize = 640);
+
+    // dynamicShape 가 false 면 (ModelLoader::readModel 로 확인) 배치 1, 입력 크기 고정으로만 써야 한다
+    void setModel(cv::dnn::Net model, bool dynamicShape = true);
+    bool empty() const { return net.empty(); }
+    bool isDynamic() const { return dynamic; }
+
+    void setInputSize(int size);
+    int inputSize() const { return preprocessor.inputSize(); }
+
+    YoloDecoder &decoder() { return yoloDecoder; }
+
+    // 배치 버퍼를 count 장 이상으로 확보 (이미 충분하면 아무것도 안 함)
+    void reserve(int count);
+
+    // 슬롯 index 에 레터박스 전처리
+    LetterboxInfo prepare(int index, const cv::Mat &image);
+
+    // 이미 전처리된 blob 을 직접 채울 슬롯 (3 * S * S float)
+    float *slot(int index);
+
+    // 앞의 count 장으로 forward 1회 → results[i] 는 i 번째 장의 검출 (네트워크 입력 좌표)
+    void run(int count, std::vector<std::vector<Detection>> &results);
+
+private:
+    cv::dnn::Net net;
+    std::vector<cv::String> outputNames;
+    bool dynamic;
+    Preprocessor preprocessor;
+    YoloDecoder yoloDecoder;
+
+    cv::Mat batchBlob;      // (capacity, 3, S, S)
+    int capacity;
+    std::vector<cv::Mat> outputs;
+};
@@ -0,0 +1,103 @@
+// boundedqueue.h
+#pragma once
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <deque>
+#include <vector>
+
+// 다중 생산자 / 다중 소비자 고정 크기 큐.
+// push 는 가득 차면 대기 (block), tryPush 는 가득 차면 바로 실패 (drop). close 후에는 남은 항목만 꺼낼 수 있다.
+template <typename T>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(int capacity) : capacity(capacity), closed(false) {}
+
+    bool push(const T &value)
+    {
+        QMutexLocker locker(&mutex);
+        while (int(items.size()) >= capacity && !closed)
+            notFull.wait(&mutex);
+        if (closed)
+            return false;
+
+        items.push_back(value);
+        notEmpty.wakeOne();
+        return true;
+    }
+
+    bool tryPush(const T &value)
+    {
+        QMutexLocker locker(&mutex);
+        if (closed || int(items.size()) >= capacity)
+            return false;
+
+        items.push_back(value);
+        notEmpty.wakeOne();
+        return true;
+    }
+
+    bool pop(T &value)
+    {
+        QMutexLocker locker(&mutex);
+        while (items.empty() && !closed)
+            notEmpty.wait(&mutex);
+        if (items.empty())
+            return false;
+
+        value = items.front();
+        items.pop_front();
+        notFull.wakeOne();
+        return true;
+    }
+
+    // 배치 수집: 첫 항목은 올 때까지 대기하고, 그 뒤 timeoutMs 안에 maxItems 개까지 모은다.
+    // close 되고 비어 있으면 0
+    int popBatch(std::vector<T> &batch, int maxItems, int timeoutMs)
+    {
+        batch.clear();
+        QMutexLocker locker(&mutex);
+        while (items.empty() && !closed)
+            notEmpty.wait(&mutex);
+
+        QElapsedTimer timer;
+        timer.start();
+        while (int(batch.size()) < maxItems) {
+            if (items.empty()) {
+                const qint64 remaining = timeoutMs - timer.elapsed();
+                if (closed || remaining <= 0)
+                    break;
+                notEmpty.wait(&mutex, static_cast<unsigned long>(remaining));
+                continue;
+            }
+            batch.push_back(items.front());
+            items.pop_front();
+            notFull.wakeOne();
+        }
+        return int(batch.size());
+    }
+
+    void close()
+    {
+        QMutexLocker locker(&mutex);
+        closed = true;
+        notEmpty.wakeAll();
+        notFull.wakeAll();
+    }
+
+    int size() const
+    {
+        QMutexLocker locker(&mutex);
+        return int(items.size());
+    }
+
+private:
+    mutable QMutex mutex;
+    QWaitCondition notEmpty;
+    QWaitCondition notFull;
+    std::deque<T> items;
+    int capacity;
+    bool closed;
+};
@@ -0,0 +1,155 @@
+// captureencoder.cpp
+#include "captureencoder.h"
+#include "tracing.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QRunnable>
+#include <QSaveFile>
+#include <vector>
+#include <opencv2/imgcodecs.hpp>
+
+// 캡처 한 장 인코딩 작업 (프레임 버퍼는 저장이 끝날 때까지 잡아 둔다)
+class EncodeTask : public QRunnable
+{
+public:
+    EncodeTask(CaptureEncoder *encoder, const FramePtr &frame, const QString &path)
+        : encoder(encoder), frame(frame), path(path)
+    {
+    }
+
+    void run() override { encoder->encode(frame, path); }
+
+private:
+    CaptureEncoder *encoder;
+    FramePtr frame;
+    QString path;
+};
+
+CaptureEncoder::CaptureEncoder(const EncodeSettings &encodeSettings, QObject *parent)
+    : QObject(parent)
+    , settings(encodeSettings)
+    , queued(0)
+    , saved(0)
+    , dropped(0)
+    , counter(0)
+    , bursting(false)
+    , burstStartUs(0)
+    , lastBurstUs(0)
+    , burstFrames(0)
+    , burstSaved(0)
+    , burstDropped(0)
+{
+    settings.format = settings.format.toLower() == "png" ? "png" : "jpg";
+    settings.quality = qBound(0, settings.quality, 100);
+    settings.pngLevel = qBound(0, settings.pngLevel, 9);
+    settings.queueCapacity = qMax(1, settings.queueCapacity);
+    pool.setMaxThreadCount(qMax(1, settings.workers));
+}
+
+CaptureEncoder::~CaptureEncoder()
+{
+    pool.waitForDone();
+}
+
+QString CaptureEncoder::nextPath(const QString &directory)
+{
+    // capture_20250101123045123_000042.jpg : 이름 순서 = 캡처 순서
+    return QString("%1/capture_%2_%3.%4")
+        .arg(directory)
+        .arg(QDateTime::currentDateTime().toString("yyyyMMddHHmmsszzz"))
+        .arg(++counter, 6, 10, QChar('0'))
+        .arg(settings.format);
+}
+
+bool CaptureEncoder::capture(const FramePtr &frame, const QString &directory)
+{
+    if (!frame || frame->image.empty())
+        return false;
+
+    // 🔥 디스크가 느려도 캡처 / 추론 프레임은 막지 않고 이 캡처만 버린다
+    if (queued.load() >= settings.queueCapacity) {
+        dropped++;
+        return false;
+    }
+
+    queued++;
+    pool.start(new EncodeTask(this, frame, nextPath(directory)));
+    return true;
+}
+
+void CaptureEncoder::encode(const FramePtr &frame, const QString &path)
+{
+    TRACE_SCOPE("capture.encode", frame->sequence);
+
+    std::vector<int> params;
+    if (settings.format == "png")
+        params = { cv::IMWRITE_PNG_COMPRESSION, settings.pngLevel };
+    else
+        params = { cv::IMWRITE_JPEG_QUALITY, settings.quality };
+
+    // BGR 원본 그대로 인코딩 (QImage 변환 없음), 임시 파일에 쓰고 rename 해서 목록 스캔에 반쯤 쓴 파일이 안 보이게
+    std::vector<uchar> buffer;
+    bool ok = cv::imencode("." + settings.format.toStdString(), frame->image, buffer, params);
+    if (ok) {
+        QSaveFile file(path);
+        ok = file.open(QIODevice::WriteOnly)
+             && file.write(reinterpret_cast<const char *>(buffer.data()), qint64(buffer.size())) == qint64(buffer.size())
+             && file.commit();
+    }
+
+    queued--;
+    if (ok) {
+        saved++;
+        emit frameSaved(path);
+    } else {
+        emit saveFailed(path);
+    }
+}
+
+void CaptureEncoder::startBurst(const QString &directory)
+{
+    bursting = true;
+    burstDirectory = directory;
+    burstStartUs = frameClockUs();
+    lastBurstUs = 0;
+    burstFrames = 0;
+    burstSaved = 0;
+    burstDropped = 0;
+}
+
+void CaptureEncoder::stopBurst()
+{
+    if (!bursting)
+        return;
+    bursting = false;
+    emit burstFinished(burstSaved, burstDropped);
+}
+
+void CaptureEncoder::offer(const FramePtr &frame)
+{
+    if (!bursting)
+        return;
+
+    const BurstSettings &burst = settings.burst;
+    if (burst.durationSec > 0 && frameClockUs() - burstStartUs >= qint64(burst.durationSec) * 1000000) {
+        stopBurst();
+        return;
+    }
+
+    // N 프레임마다, 또는 프레임 타임스탬프 기준 최대 maxFps
+    const quint64 index = burstFrames++;
+    if (burst.everyNth > 0) {
+        if (index % quint64(burst.everyNth) != 0)
+            return;
+    } else if (burst.maxFps > 0 && lastBurstUs != 0
+               && frame->timestampUs - lastBurstUs < qint64(1000000 / burst.maxFps)) {
+        return;
+    }
+    lastBurstUs = frame->timestampUs;
+
+    if (capture(frame, burstDirectory))
+        burstSaved++;
+    else
+        burstDropped++;
+}
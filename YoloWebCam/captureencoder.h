@@ -0,0 +1,74 @@
+// captureencoder.h
+#pragma once
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <atomic>
+#include "framepool.h"
+
+// 연속 캡처: everyNth 가 있으면 N 프레임마다, 없으면 최대 maxFps 로 durationSec 동안 (0 이면 끌 때까지)
+struct BurstSettings {
+    int everyNth = 0;
+    double maxFps = 5;
+    int durationSec = 10;
+};
+
+// 캡처 저장 설정
+struct EncodeSettings {
+    QString format = "jpg";   // jpg 또는 png
+    int quality = 95;         // jpg 품질 0~100
+    int pngLevel = 3;         // png 압축 0~9 (0 은 무압축이라 파일이 크고, 9 는 느림)
+    int workers = 2;          // 인코딩 스레드 수
+    int queueCapacity = 32;   // 저장 대기 프레임 상한, 넘치면 그 캡처는 버림 (라이브 프레임은 막지 않음)
+    BurstSettings burst;
+};
+
+// 캡처 프레임을 공유 버퍼 그대로 받아 스레드 풀에서 인코딩 / 저장한다.
+// 파일명은 캡처 시각(ms) + 세션 순번이라 같은 초에 여러 장을 찍어도 덮어쓰지 않는다
+class CaptureEncoder : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CaptureEncoder(const EncodeSettings &settings = EncodeSettings(), QObject *parent = nullptr);
+    ~CaptureEncoder();   // 대기 중인 캡처는 모두 저장하고 끝낸다
+
+    // 한 장 저장 요청. 대기열이 차 있으면 false
+    bool capture(const FramePtr &frame, const QString &directory);
+
+    void startBurst(const QString &directory);
+    void stopBurst();
+    bool isBursting() const { return bursting; }
+
+    // 선택된 소스의 프레임마다 호출 (버스트 중이고 간격이 맞으면 저장)
+    void offer(const FramePtr &frame);
+
+    int pendingCount() const { return queued.load(); }
+    quint64 savedCount() const { return saved.load(); }
+    quint64 droppedCount() const { return dropped; }
+
+signals:
+    void frameSaved(const QString &path);
+    void saveFailed(const QString &path);
+    void burstFinished(int savedFrames, int droppedFrames);
+
+private:
+    friend class EncodeTask;
+    void encode(const FramePtr &frame, const QString &path);
+    QString nextPath(const QString &directory);
+
+    EncodeSettings settings;
+    QThreadPool pool;
+    std::atomic<int> queued;
+    std::atomic<quint64> saved;
+    quint64 dropped;
+    quint64 counter;           // 세션 안에서 단조 증가하는 파일 순번
+
+    bool bursting;
+    QString burstDirectory;
+    qint64 burstStartUs;
+    qint64 lastBurstUs;
+    quint64 burstFrames;       // 버스트 중 받은 프레임 수
+    int burstSaved;
+    int burstDropped;
+};
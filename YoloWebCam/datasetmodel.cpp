@@ -0,0 +1,279 @@
+// datasetmodel.cpp
+#include "datasetmodel.h"
+
+#include <QBrush>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+#include <algorithm>
+
+namespace {
+
+const int kFetchChunk = 500;   // 뷰가 스크롤할 때마다 노출하는 행 수
+
+bool entryLess(const DatasetEntry &entry, const QString &fileName)
+{
+    return entry.fileName < fileName;
+}
+
+} // namespace
+
+void DatasetScanner::scan(int generation, const QString &imagesPath, const QString &labelsPath)
+{
+    QStringList filters;
+    filters << "*.png" << "*.jpg" << "*.jpeg" << "*.bmp";
+    const QStringList images = QDir(imagesPath).entryList(filters, QDir::Files | QDir::NoDotAndDotDot, QDir::NoSort);
+
+    // 라벨 파일 목록을 한 번만 읽어 basename 집합으로
+    QSet<QString> labels;
+    const QStringList labelFiles = QDir(labelsPath).entryList(QStringList() << "*.txt", QDir::Files | QDir::NoDotAndDotDot, QDir::NoSort);
+    labels.reserve(labelFiles.size());
+    for (const QString &name : labelFiles)
+        labels.insert(name.left(name.size() - 4));
+
+    QVector<DatasetEntry> entries;
+    entries.reserve(images.size());
+    for (const QString &name : images) {
+        DatasetEntry entry;
+        entry.fileName = name;
+        entry.labeled = labels.contains(QFileInfo(name).completeBaseName());
+        entries.push_back(entry);
+    }
+    std::sort(entries.begin(), entries.end(), [](const DatasetEntry &a, const DatasetEntry &b) {
+        return a.fileName < b.fileName;
+    });
+
+    emit scanned(generation, entries);
+}
+
+DatasetModel::DatasetModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , loaded(0)
+    , generation(0)
+    , scanning(false)
+    , rescanPending(false)
+    , populated(false)
+{
+    qRegisterMetaType<QVector<DatasetEntry>>("QVector<DatasetEntry>");
+
+    scanner = new DatasetScanner();
+    scanner->moveToThread(&scanThread);
+    connect(&scanThread, &QThread::finished, scanner, &QObject::deleteLater);
+    connect(this, &DatasetModel::requestScan, scanner, &DatasetScanner::scan);
+    connect(scanner, &DatasetScanner::scanned, this, &DatasetModel::onScanned);
+    scanThread.start();
+
+    rescanTimer.setSingleShot(true);
+    rescanTimer.setInterval(300);
+    connect(&rescanTimer, &QTimer::timeout, this, &DatasetModel::scheduleRescan);
+    connect(&watcher, &QFileSystemWatcher::directoryChanged, this, [this]() { rescanTimer.start(); });
+}
+
+DatasetModel::~DatasetModel()
+{
+    scanThread.quit();
+    scanThread.wait();
+}
+
+void DatasetModel::setDirectories(const QString &images, const QString &labels)
+{
+    generation++;
+    rescanTimer.stop();
+    rescanPending = false;
+
+    beginResetModel();
+    entries.clear();
+    loaded = 0;
+    populated = false;
+    endResetModel();
+    emit countChanged(0);
+
+    if (!watcher.directories().isEmpty())
+        watcher.removePaths(watcher.directories());
+    imagesPath = images;
+    labelsPath = labels;
+    for (const QString &path : { imagesPath, labelsPath }) {
+        if (QFileInfo(path).isDir())
+            watcher.addPath(path);
+    }
+
+    scanning = true;
+    emit requestScan(generation, imagesPath, labelsPath);
+}
+
+void DatasetModel::scheduleRescan()
+{
+    // 스캔 중이면 끝난 뒤 한 번 더
+    if (scanning) {
+        rescanPending = true;
+        return;
+    }
+    scanning = true;
+    emit requestScan(generation, imagesPath, labelsPath);
+}
+
+void DatasetModel::onScanned(int scanGeneration, const QVector<DatasetEntry> &scannedEntries)
+{
+    if (scanGeneration != generation)
+        return;  // 이미 다른 폴더로 바뀜
+    scanning = false;
+
+    if (!populated || qAbs(scannedEntries.size() - entries.size()) > kFetchChunk) {
+        // 첫 스캔 (또는 한꺼번에 많이 바뀜): 목록만 바꾸고 행은 fetchMore 로 조금씩 노출
+        beginResetModel();
+        entries = scannedEntries;
+        loaded = 0;
+        populated = true;
+        endResetModel();
+    } else {
+        // 🔥 두 정렬 목록을 병합하며 달라진 행만 추가 / 삭제 / 갱신 (선택 / 스크롤 위치 유지)
+        int i = 0;
+        int j = 0;
+        while (i < entries.size() || j < scannedEntries.size()) {
+            if (j >= scannedEntries.size()
+                || (i < entries.size() && entries[i].fileName < scannedEntries[j].fileName)) {
+                removeEntry(i);
+                continue;
+            }
+            if (i >= entries.size() || scannedEntries[j].fileName < entries[i].fileName) {
+                insertEntry(i, scannedEntries[j]);
+            } else if (entries[i].labeled != scannedEntries[j].labeled) {
+                entries[i].labeled = scannedEntries[j].labeled;
+                if (i < loaded)
+                    emit dataChanged(index(i), index(i), { Qt::ForegroundRole });
+            }
+            ++i;
+            ++j;
+        }
+    }
+    emit countChanged(entries.size());
+
+    if (rescanPending) {
+        rescanPending = false;
+        scheduleRescan();
+    }
+}
+
+int DatasetModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : loaded;
+}
+
+QVariant DatasetModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= loaded)
+        return QVariant();
+
+    const DatasetEntry &entry = entries[index.row()];
+    if (role == Qt::DisplayRole)
+        return entry.fileName;
+    if (role == Qt::ForegroundRole)
+        return QBrush(entry.labeled ? Qt::blue : Qt::red);  // 라벨 있음: 파랑, 없음: 빨강
+    return QVariant();
+}
+
+bool DatasetModel::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && loaded < entries.size();
+}
+
+void DatasetModel::fetchMore(const QModelIndex &parent)
+{
+    if (parent.isValid())
+        return;
+    const int count = qMin(kFetchChunk, entries.size() - loaded);
+    if (count <= 0)
+        return;
+
+    beginInsertRows(QModelIndex(), loaded, loaded + count - 1);
+    loaded += count;
+    endInsertRows();
+}
+
+QString DatasetModel::fileName(int row) const
+{
+    return row >= 0 && row < entries.size() ? entries[row].fileName : QString();
+}
+
+int DatasetModel::lowerBound(const QString &name) const
+{
+    return int(std::lower_bound(entries.begin(), entries.end(), name, entryLess) - entries.begin());
+}
+
+int DatasetModel::rowOf(const QString &name) const
+{
+    const int row = lowerBound(name);
+    return row < entries.size() && entries[row].fileName == name ? row : -1;
+}
+
+void DatasetModel::insertEntry(int row, const DatasetEntry &entry)
+{
+    // 노출된 범위 안이거나 전부 노출된 상태에서 끝에 붙으면 뷰에도 알림
+    const bool visible = row < loaded || loaded == entries.size();
+    if (visible)
+        beginInsertRows(QModelIndex(), row, row);
+    entries.insert(row, entry);
+    if (visible) {
+        loaded++;
+        endInsertRows();
+    }
+}
+
+void DatasetModel::removeEntry(int row)
+{
+    const bool visible = row < loaded;
+    if (visible)
+        beginRemoveRows(QModelIndex(), row, row);
+    entries.remove(row);
+    if (visible) {
+        loaded--;
+        endRemoveRows();
+    }
+}
+
+void DatasetModel::addImage(const QString &name)
+{
+    const int row = lowerBound(name);
+    if (row < entries.size() && entries[row].fileName == name)
+        return;
+
+    DatasetEntry entry;
+    entry.fileName = name;
+    entry.labeled = QFile::exists(labelsPath + "/" + QFileInfo(name).completeBaseName() + ".txt");
+    insertEntry(row, entry);
+    emit countChanged(entries.size());
+}
+
+void DatasetModel::removeImage(const QString &name)
+{
+    const int row = rowOf(name);
+    if (row < 0)
+        return;
+    removeEntry(row);
+    emit countChanged(entries.size());
+}
+
+void DatasetModel::setLabeledByLabelPath(const QString &labelPath, bool labeled)
+{
+    const QFileInfo info(labelPath);
+    if (QDir::cleanPath(info.absolutePath()) != QDir::cleanPath(QFileInfo(labelsPath).absoluteFilePath()))
+        return;
+
+    // 라벨 이름에는 이미지 확장자가 없으므로 같은 이름으로 시작하는 행들 중에서 찾는다
+    const QString baseName = info.completeBaseName();
+    for (int row = lowerBound(baseName); row < entries.size() && entries[row].fileName.startsWith(baseName); ++row) {
+        if (QFileInfo(entries[row].fileName).completeBaseName() == baseName)
+            setLabeled(entries[row].fileName, labeled);
+    }
+}
+
+void DatasetModel::setLabeled(const QString &name, bool labeled)
+{
+    const int row = rowOf(name);
+    if (row < 0 || entries[row].labeled == labeled)
+        return;
+    entries[row].labeled = labeled;
+    if (row < loaded)
+        emit dataChanged(index(row), index(row), { Qt::ForegroundRole });
+}
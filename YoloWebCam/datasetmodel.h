@@ -0,0 +1,89 @@
+// datasetmodel.h
+#pragma once
+#include <QAbstractListModel>
+#include <QFileSystemWatcher>
+#include <QMetaType>
+#include <QString>
+#include <QThread>
+#include <QTimer>
+#include <QVector>
+
+// images/<split> 의 이미지 하나 + 라벨 파일 유무
+struct DatasetEntry {
+    QString fileName;
+    bool labeled = false;
+};
+
+Q_DECLARE_METATYPE(QVector<DatasetEntry>)
+
+// 백그라운드 스레드에서 폴더를 한 번씩 훑어 정렬된 목록을 만든다.
+// 라벨 유무는 파일마다 QFile::exists 대신 labels 폴더 목록 한 번으로 확인
+class DatasetScanner : public QObject
+{
+    Q_OBJECT
+
+public slots:
+    void scan(int generation, const QString &imagesPath, const QString &labelsPath);
+
+signals:
+    void scanned(int generation, const QVector<DatasetEntry> &entries);
+};
+
+// 데이터셋 파일 목록 모델.
+// 처음 목록은 백그라운드 스캔 결과로 채우고, 이후에는 QFileSystemWatcher / 캡처 / 삭제 / 라벨 저장 이벤트로
+// 바뀐 행만 추가 / 삭제 / 갱신한다. 뷰에는 fetchMore 로 스크롤하는 만큼만 행을 노출
+class DatasetModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    explicit DatasetModel(QObject *parent = nullptr);
+    ~DatasetModel();
+
+    // 다른 폴더 (split) 로 전환: 목록을 비우고 백그라운드 스캔 시작
+    void setDirectories(const QString &imagesPath, const QString &labelsPath);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+    int totalCount() const { return entries.size(); }   // 아직 뷰에 노출되지 않은 행 포함
+    bool isScanning() const { return scanning; }
+    QString fileName(int row) const;
+    int rowOf(const QString &fileName) const;           // 없으면 -1
+
+    // 앱이 직접 바꾼 파일은 스캔 없이 바로 반영
+    void addImage(const QString &fileName);
+    void removeImage(const QString &fileName);
+    void setLabeled(const QString &fileName, bool labeled);
+    void setLabeledByLabelPath(const QString &labelPath, bool labeled);   // 다른 split 의 라벨이면 무시
+
+signals:
+    void countChanged(int total);
+    void requestScan(int generation, const QString &imagesPath, const QString &labelsPath);
+
+private slots:
+    void onScanned(int generation, const QVector<DatasetEntry> &scannedEntries);
+
+private:
+    int lowerBound(const QString &fileName) const;
+    void insertEntry(int row, const DatasetEntry &entry);
+    void removeEntry(int row);
+    void scheduleRescan();
+
+    QVector<DatasetEntry> entries;   // 파일명 순 정렬
+    int loaded;                      // 뷰에 노출된 행 수 (entries 의 앞부분)
+    int generation;                  // setDirectories 마다 증가 (이전 폴더의 늦은 스캔 결과는 버림)
+    bool scanning;
+    bool rescanPending;
+    bool populated;                  // 현재 폴더의 첫 스캔 결과를 받았는지
+
+    QString imagesPath;
+    QString labelsPath;
+
+    QThread scanThread;
+    DatasetScanner *scanner;
+    QFileSystemWatcher watcher;
+    QTimer rescanTimer;              // 파일이 여러 개 바뀌면 모아서 한 번만
+};
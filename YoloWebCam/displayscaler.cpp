@@ -0,0 +1,14 @@
+// displayscaler.cpp
+#include "displayscaler.h"
+#include "tracing.h"
+
+void DisplayScaler::scale(const QImage &image, const QSize &target, bool smooth, quint64 frameId)
+{
+    TRACE_THREAD_NAME("display");
+    TRACE_SCOPE("display.scale", frameId);
+
+    // 🔥 라이브 영상은 FastTransformation (nearest), 정지 이미지만 SmoothTransformation
+    QImage result = image.scaled(target, Qt::KeepAspectRatio,
+                                 smooth ? Qt::SmoothTransformation : Qt::FastTransformation);
+    emit scaled(result, frameId);
+}
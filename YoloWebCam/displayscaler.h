@@ -0,0 +1,18 @@
+// displayscaler.h
+#pragma once
+#include <QImage>
+#include <QObject>
+#include <QSize>
+
+// 화면 표시용 축소를 GUI 스레드 밖에서 하는 워커.
+// MainWindow 가 화면 주사율마다 최신 이미지 하나만 넘기고, 결과가 오기 전에는 다음 것을 넘기지 않는다
+class DisplayScaler : public QObject
+{
+    Q_OBJECT
+
+public slots:
+    void scale(const QImage &image, const QSize &target, bool smooth, quint64 frameId);
+
+signals:
+    void scaled(const QImage &image, quint64 frameId);
+};
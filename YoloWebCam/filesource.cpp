@@ -0,0 +1,160 @@
+// filesource.cpp
+#include "filesource.h"
+#include "tracing.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QThread>
+#include <opencv2/imgcodecs.hpp>
+
+FileSource::FileSource(const QString &sourceLocation, const ReplaySettings &replaySettings, int sourceId, QObject *parent)
+    : FrameSource(sourceId, parent)
+    , location(sourceLocation)
+    , replay(replaySettings)
+    , frameIndex(0)
+    , lastTimestampMs(-1)
+    , fps(30.0)
+{
+}
+
+FileSource::~FileSource()
+{
+    stop();
+}
+
+void FileSource::loadTimestamps(const QString &path)
+{
+    timestamps.clear();
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return;
+
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        const QStringList parts = in.readLine().split(' ', QString::SkipEmptyParts);
+        if (!parts.isEmpty())
+            timestamps.push_back(parts.last().toLongLong());
+    }
+}
+
+bool FileSource::open()
+{
+    // 매 재생마다 처음부터 다시 연다 (seek 보다 디코더 상태가 확실히 같음)
+    imageFiles.clear();
+    frameIndex = 0;
+    lastTimestampMs = -1;
+    fps = 30.0;
+
+    const QFileInfo info(location);
+    if (info.isDir()) {
+        QStringList filters;
+        filters << "*.png" << "*.jpg" << "*.jpeg" << "*.bmp";
+        QDir dir(location);
+        for (const QString &name : dir.entryList(filters, QDir::Files, QDir::Name))
+            imageFiles << dir.filePath(name);
+        loadTimestamps(dir.filePath("timestamps.txt"));
+        return !imageFiles.isEmpty();
+    }
+
+    cap.release();
+    if (!cap.open(location.toStdString()))
+        return false;
+    const double fileFps = cap.get(cv::CAP_PROP_FPS);
+    if (fileFps > 0 && fileFps < 1000)
+        fps = fileFps;
+    loadTimestamps(info.dir().filePath(info.completeBaseName() + ".timestamps.txt"));
+    return true;
+}
+
+bool FileSource::readFrame(cv::Mat &image, qint64 &timestampMs)
+{
+    if (!imageFiles.isEmpty()) {
+        if (frameIndex >= imageFiles.size())
+            return false;
+        image = cv::imread(imageFiles[frameIndex].toStdString(), cv::IMREAD_COLOR);
+    } else if (!cap.read(image)) {
+        return false;
+    }
+
+    // 사이드카 → 동영상 PTS → 고정 간격 순서. 시각이 뒤로 가면 고정 간격으로 대체
+    if (frameIndex < int(timestamps.size()))
+        timestampMs = timestamps[frameIndex];
+    else if (imageFiles.isEmpty())
+        timestampMs = qint64(cap.get(cv::CAP_PROP_POS_MSEC));
+    else
+        timestampMs = -1;
+    if (timestampMs < 0 || (frameIndex > 0 && timestampMs <= lastTimestampMs))
+        timestampMs = qint64(frameIndex * 1000.0 / fps);
+
+    lastTimestampMs = timestampMs;
+    frameIndex++;
+    return true;
+}
+
+void FileSource::waitForTurn(qint64 dueUs)
+{
+    if (replay.mode == ReplaySettings::Fast) {
+        // 🔥 앞 프레임이 파이프라인을 빠져나갈 때까지 대기 → 드롭 없이 소비자 속도로 재생
+        //    (지금 읽은 프레임도 inUse 에 포함)
+        while (running && pool.inUse() > replay.maxInFlight)
+            QThread::usleep(200);
+        return;
+    }
+
+    // 🔥 sleep 누적 오차가 쌓이지 않게 재생 시작 시각 + 녹화 시각을 목표로
+    const qint64 waitUs = dueUs - frameClockUs();
+    if (waitUs > 0)
+        QThread::usleep(quint64(waitUs));
+}
+
+void FileSource::start()
+{
+    if (running.exchange(true)) return;
+    TRACE_THREAD_NAME("file");
+
+    for (int loop = 0; running && (replay.loops <= 0 || loop < replay.loops); ++loop) {
+        if (!open()) {
+            qWarning("Failed to open source: %s", qPrintable(location));
+            break;
+        }
+
+        qint64 timestampMs = 0;
+        qint64 playStartUs = -1;
+        int published = 0;
+
+        while (running) {
+            std::shared_ptr<Frame> frame = pool.acquire();
+            {
+                TRACE_SCOPE("file.read", sequence + 1);
+                if (!readFrame(frame->image, timestampMs))
+                    break;  // 이번 재생 끝
+            }
+            if (frame->image.empty() || timestampMs < replay.startOffsetMs)
+                continue;   // 읽을 수 없는 이미지 / 시작 오프셋 이전
+
+            if (playStartUs < 0)
+                playStartUs = frameClockUs();
+            waitForTurn(playStartUs + (timestampMs - replay.startOffsetMs) * 1000);
+            if (!running)
+                break;
+
+            publish(frame, frameClockUs());
+            published++;
+        }
+
+        // 한 바퀴에 내보낸 프레임이 없으면 (오프셋이 끝보다 뒤 / 전부 디코딩 실패) 다시 열어도 같으므로 끝낸다
+        if (running && published == 0) {
+            qWarning("No frames to replay in %s (start offset %lld ms)", qPrintable(location), replay.startOffsetMs);
+            break;
+        }
+    }
+
+    // stop() 으로 멈춘 경우가 아니라 끝까지 재생했을 때만 finished
+    const bool completed = running;
+    cap.release();
+    running = false;
+    if (completed)
+        emit finished();
+}
@@ -0,0 +1,43 @@
+// filesource.h
+#pragma once
+#include <QString>
+#include <QStringList>
+#include <vector>
+#include <opencv2/core.hpp>
+#include <opencv2/videoio.hpp>
+#include "framesource.h"
+
+// 동영상 파일 또는 이미지 폴더를 카메라처럼 재생하는 소스.
+// 카메라 없이 (CI / 헤드리스 서버) 캡처 → 추론 → 표시 전체를 매번 같은 입력으로 돌릴 수 있다.
+//
+// 프레임 시각은 동영상의 PTS, 폴더는 timestamps.txt (없으면 30 fps 간격) 를 쓰고,
+// 동영상 옆에 <이름>.timestamps.txt 가 있으면 그쪽이 우선한다 (한 줄에 "<index> <ms>").
+class FileSource : public FrameSource
+{
+    Q_OBJECT
+
+public:
+    explicit FileSource(const QString &location, const ReplaySettings &replay = ReplaySettings(),
+                        int sourceId = 0, QObject *parent = nullptr);
+    ~FileSource();
+
+    bool isReplay() const override { return true; }
+
+public slots:
+    void start() override;
+
+private:
+    bool open();
+    void loadTimestamps(const QString &path);
+    bool readFrame(cv::Mat &image, qint64 &timestampMs);
+    void waitForTurn(qint64 dueUs);
+
+    QString location;
+    ReplaySettings replay;
+    cv::VideoCapture cap;
+    QStringList imageFiles;          // 폴더일 때 이름순 이미지 목록
+    std::vector<qint64> timestamps;  // 사이드카에서 읽은 프레임별 시각 (ms)
+    int frameIndex;                  // 이번 재생에서 읽은 프레임 수
+    qint64 lastTimestampMs;
+    double fps;
+};
@@ -0,0 +1,72 @@
+// framemailbox.h
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+struct MailboxStats {
+    uint64_t posted = 0;     // 생산자가 넣은 프레임 수
+    uint64_t processed = 0;  // 소비자가 꺼내간 프레임 수
+    uint64_t dropped = 0;    // 소비되기 전에 새 프레임으로 덮어써진 수
+};
+
+// 단일 생산자 / 단일 소비자 latest-frame-wins 메일박스 (lock-free triple buffer).
+// 드롭 정책: 소비자가 아직 가져가지 않은 프레임은 새 프레임이 오면 버려진다.
+// 슬롯은 항상 3개뿐이라 소비자가 아무리 느려도 메모리는 일정하다.
+template <typename T>
+class FrameMailbox
+{
+public:
+    FrameMailbox() : state(kMiddle), front(kFront), back(kBack) {}
+
+    // 생산자 스레드에서만 호출
+    void post(const T &value)
+    {
+        slots[back] = value;
+        const int prev = state.exchange(back | kFresh, std::memory_order_acq_rel);
+        back = prev & kIndexMask;
+
+        posted.fetch_add(1, std::memory_order_relaxed);
+        if (prev & kFresh)
+            dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 소비자 스레드에서만 호출. 새 프레임이 없으면 false
+    bool take(T &value)
+    {
+        if (!(state.load(std::memory_order_acquire) & kFresh))
+            return false;
+
+        const int prev = state.exchange(front, std::memory_order_acq_rel);
+        front = prev & kIndexMask;
+        value = slots[front];
+
+        processed.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool hasPending() const
+    {
+        return (state.load(std::memory_order_acquire) & kFresh) != 0;
+    }
+
+    MailboxStats stats() const
+    {
+        MailboxStats s;
+        s.posted = posted.load(std::memory_order_relaxed);
+        s.processed = processed.load(std::memory_order_relaxed);
+        s.dropped = dropped.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    enum { kFront = 0, kBack = 1, kMiddle = 2, kIndexMask = 0x3, kFresh = 0x4 };
+
+    T slots[3];
+    std::atomic<int> state;   // 가운데 슬롯 인덱스 | kFresh
+    int front;                // 소비자 전용
+    int back;                 // 생산자 전용
+
+    std::atomic<uint64_t> posted{0};
+    std::atomic<uint64_t> processed{0};
+    std::atomic<uint64_t> dropped{0};
+};
@@ -0,0 +1,75 @@
+// framepool.cpp
+#include "framepool.h"
+
+FramePool::State::~State()
+{
+    for (Frame *frame : free)
+        delete frame;
+}
+
+FramePool::FramePool(int capacity)
+    : state(std::make_shared<State>())
+{
+    state->capacity = capacity;
+    state->inUse = 0;
+    state->free.reserve(capacity);
+}
+
+int FramePool::inUse() const
+{
+    QMutexLocker locker(&state->mutex);
+    return state->inUse;
+}
+
+std::shared_ptr<Frame> FramePool::acquire()
+{
+    Frame *frame = nullptr;
+    {
+        QMutexLocker locker(&state->mutex);
+        state->inUse++;
+        if (!state->free.empty()) {
+            frame = state->free.back();
+            state->free.pop_back();
+        }
+    }
+    if (!frame)
+        frame = new Frame();  // 풀이 비어 있으면 새로 만들고, 반납 시 capacity 까지만 보관
+
+    std::weak_ptr<State> weakState = state;
+    return std::shared_ptr<Frame>(frame, [weakState](Frame *released) {
+        std::shared_ptr<State> owner = weakState.lock();
+        if (owner) {
+            QMutexLocker locker(&owner->mutex);
+            owner->inUse--;
+            if (int(owner->free.size()) < owner->capacity) {
+                released->sequence = 0;
+                released->timestampUs = 0;
+                released->sourceId = 0;
+                owner->free.push_back(released);
+                return;
+            }
+        }
+        delete released;
+    });
+}
+
+static void releaseFrame(void *info)
+{
+    delete static_cast<FramePtr *>(info);
+}
+
+QImage frameToQImage(const FramePtr &frame)
+{
+    if (!frame || frame->image.empty())
+        return QImage();
+
+    const cv::Mat &mat = frame->image;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+    // const 데이터로 만들기 때문에 QPainter 등으로 수정하면 그때 QImage 가 알아서 복사한다
+    return QImage(static_cast<const uchar *>(mat.data), mat.cols, mat.rows, int(mat.step), QImage::Format_BGR888,
+                  releaseFrame, new FramePtr(frame));
+#else
+    // Format_BGR888 이 없는 Qt 에서는 채널 스왑 복사 한 번
+    return QImage(mat.data, mat.cols, mat.rows, int(mat.step), QImage::Format_RGB888).rgbSwapped();
+#endif
+}
@@ -0,0 +1,56 @@
+// framepool.h
+#pragma once
+#include <QImage>
+#include <QMetaType>
+#include <QMutex>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <opencv2/core.hpp>
+
+// 캡처된 프레임 하나. 캡처 후에는 화면 / 추론 / 저장이 읽기 전용으로 공유한다
+struct Frame {
+    cv::Mat image;          // BGR8 (캡처 원본 그대로, 색 변환 없음)
+    quint64 sequence = 0;    // 소스 안에서의 순번
+    qint64 timestampUs = 0;  // 캡처 시각 (frameClockUs 기준)
+    int sourceId = 0;        // 어느 입력 소스에서 왔는지 (FrameSource::sourceId)
+};
+
+// 파이프라인 전체가 공유하는 단조 시계 (마이크로초)
+inline qint64 frameClockUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+typedef std::shared_ptr<const Frame> FramePtr;
+
+Q_DECLARE_METATYPE(FramePtr)
+
+// 참조 카운트 기반 프레임 버퍼 풀.
+// 마지막 FramePtr 가 사라지면 버퍼가 풀로 돌아와 다음 캡처에 재사용된다 (cv::Mat 메모리 그대로)
+class FramePool
+{
+public:
+    explicit FramePool(int capacity = 8);
+
+    // 생산자 전용. 채운 뒤 FramePtr 로 넘기면 그 뒤로는 읽기 전용
+    std::shared_ptr<Frame> acquire();
+
+    // 아직 누군가 들고 있는 프레임 수 (재생 소스의 역압력 용)
+    int inUse() const;
+
+private:
+    struct State {
+        QMutex mutex;
+        std::vector<Frame *> free;
+        int capacity;
+        int inUse;
+        ~State();
+    };
+
+    std::shared_ptr<State> state;
+};
+
+// 프레임 버퍼를 복사 없이 감싸는 QImage. QImage 가 살아있는 동안 프레임도 유지된다
+QImage frameToQImage(const FramePtr &frame);
@@ -0,0 +1,59 @@
+// framesource.cpp
+#include "framesource.h"
+#include "filesource.h"
+#include "webcamworker.h"
+#include <QStringList>
+
+SourceSettings parseSourceSpec(const QString &spec, const SourceSettings &defaults)
+{
+    SourceSettings source = defaults;
+    const QStringList parts = spec.split(',');
+    source.location = parts.value(0).trimmed();
+
+    for (int i = 1; i < parts.size(); ++i) {
+        const QString key = parts[i].section('=', 0, 0).trimmed();
+        const QString value = parts[i].section('=', 1).trimmed();
+        if (key == "priority") source.priority = qMax(1, value.toInt());
+        else if (key == "min-fps") source.minFps = qMax(0.0, value.toDouble());
+        else if (key == "queue") source.queueCapacity = qMax(1, value.toInt());
+        else if (key == "mode") source.replay.mode = value == "fast" ? ReplaySettings::Fast : ReplaySettings::Recorded;
+        else if (key == "loop") source.replay.loops = qMax(0, value.toInt());
+        else if (key == "offset") source.replay.startOffsetMs = qMax<qint64>(0, value.toLongLong());
+        else if (key == "in-flight") source.replay.maxInFlight = qMax(1, value.toInt());
+        else qWarning("Unknown source option: %s", qPrintable(parts[i]));
+    }
+    return source;
+}
+
+FrameSource::FrameSource(int sourceId, QObject *parent)
+    : QObject(parent), running(false), sequence(0), id(sourceId)
+{
+}
+
+void FrameSource::stop()
+{
+    running = false;
+}
+
+void FrameSource::publish(const std::shared_ptr<Frame> &frame, qint64 timestampUs)
+{
+    frame->sequence = ++sequence;
+    frame->timestampUs = timestampUs;
+    frame->sourceId = id;
+    emit frameReady(frame);
+}
+
+FrameSource *createFrameSource(int sourceId, const SourceSettings &source, const CaptureSettings &capture)
+{
+    bool isDevice = false;
+    const int device = source.location.toInt(&isDevice);
+    if (isDevice || source.location.isEmpty()) {
+        WebcamWorker *worker = new WebcamWorker(sourceId);
+        CaptureSettings settings = capture;
+        if (isDevice)
+            settings.device = device;
+        worker->setSettings(settings);
+        return worker;
+    }
+    return new FileSource(source.location, source.replay, sourceId);
+}
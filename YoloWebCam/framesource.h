@@ -0,0 +1,68 @@
+// framesource.h
+#pragma once
+#include <QObject>
+#include <QString>
+#include <atomic>
+#include <memory>
+#include "framepool.h"
+
+struct CaptureSettings;
+
+// 파일 / 폴더 재생 방식
+struct ReplaySettings {
+    enum Mode {
+        Recorded,   // 녹화된 타임스탬프 간격 그대로
+        Fast        // 최대 속도, 단 파이프라인에 maxInFlight 장까지만 (드롭 없이 매번 같은 입력)
+    };
+    Mode mode = Recorded;
+    int loops = 0;              // 재생 횟수 (0 이면 무한 반복)
+    qint64 startOffsetMs = 0;   // 이 시각 이전 프레임은 건너뜀
+    int maxInFlight = 4;        // fast 재생에서 파이프라인에 동시에 둘 프레임 수, 표시 쪽이 들고 있는 프레임 포함 (--replay-in-flight)
+};
+
+// 입력 소스 하나의 설정 (--source "clip.mp4,priority=2,min-fps=10,queue=4,mode=fast,loop=3,offset=5000,in-flight=8")
+struct SourceSettings {
+    QString location;        // 장치 번호("0"), 동영상 파일, 이미지 폴더
+    int priority = 1;        // 추론 기회 가중치
+    double minFps = 0;       // 최소 추론 FPS 목표 (0 이면 없음)
+    int queueCapacity = 0;   // 소스별 추론 대기열 길이 (0 이면 자동)
+    ReplaySettings replay;   // 파일 / 폴더일 때만
+};
+
+// defaults 위에 spec 의 옵션을 덮어쓴다
+SourceSettings parseSourceSpec(const QString &spec, const SourceSettings &defaults = SourceSettings());
+
+// 프레임 소스 공통 인터페이스.
+// 자기 스레드에서 start() 가 캡처 루프를 돌며 frameReady 를 emit 하고, stop() 은 어느 스레드에서든 호출 가능
+class FrameSource : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FrameSource(int sourceId = 0, QObject *parent = nullptr);
+
+    int sourceId() const { return id; }
+    virtual bool isReplay() const { return false; }   // 끝이 있는 파일 / 폴더 재생이면 true (finished 를 보낸다)
+
+public slots:
+    virtual void start() = 0;
+    void stop();
+
+signals:
+    void frameReady(const FramePtr &frame);
+    void finished();   // 재생이 끝난 소스 (카메라는 emit 하지 않음)
+
+protected:
+    // 채운 프레임에 순번 / 시각 / 소스 번호를 붙여 내보낸다
+    void publish(const std::shared_ptr<Frame> &frame, qint64 timestampUs);
+
+    std::atomic<bool> running;
+    FramePool pool;
+    quint64 sequence;
+
+private:
+    int id;
+};
+
+// location 에 맞는 소스 생성: 숫자면 V4L2 장치 (capture 설정 적용), 아니면 파일 / 폴더
+FrameSource *createFrameSource(int sourceId, const SourceSettings &source, const CaptureSettings &capture);
@@ -0,0 +1,149 @@
+// imagecache.cpp
+#include "imagecache.h"
+
+#include <QImageReader>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThread>
+#include <functional>
+
+namespace {
+
+class LoadTask : public QRunnable
+{
+public:
+    typedef std::function<void()> Job;
+    explicit LoadTask(const Job &job) : job(job) {}
+    void run() override { job(); }
+
+private:
+    Job job;
+};
+
+} // namespace
+
+ImageCache::ImageCache(qint64 maxCacheBytes, QObject *parent)
+    : QObject(parent), maxBytes(maxCacheBytes), totalBytes(0)
+{
+    pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount() / 2, 4));
+}
+
+ImageCache::~ImageCache()
+{
+    pool.clear();
+    pool.waitForDone();
+}
+
+bool ImageCache::fits(const Entry &entry, const QSize &target) const
+{
+    return entry.fullSize
+        || (entry.target.width() >= target.width() && entry.target.height() >= target.height());
+}
+
+bool ImageCache::lookup(const QString &imagePath, const QSize &target, CachedImage &result)
+{
+    QMutexLocker locker(&mutex);
+    auto it = entries.find(imagePath);
+    if (it == entries.end() || !fits(*it, target))
+        return false;
+
+    recency.splice(recency.begin(), recency, it->position);
+    result = it->image;
+    return true;
+}
+
+void ImageCache::request(const QString &imagePath, const QString &labelPath, const QSize &target, int priority)
+{
+    {
+        QMutexLocker locker(&mutex);
+        auto it = entries.find(imagePath);
+        if ((it != entries.end() && fits(*it, target)) || loading.contains(imagePath))
+            return;
+        loading.insert(imagePath);
+    }
+
+    pool.start(new LoadTask([this, imagePath, labelPath, target]() {
+        load(imagePath, labelPath, target);
+    }), priority);
+}
+
+void ImageCache::load(const QString &imagePath, const QString &labelPath, const QSize &target)
+{
+    // 🔥 JPEG 은 디코딩 단계에서 바로 표시 크기로 축소 (원본 전체를 풀었다 줄이지 않음)
+    QImageReader reader(imagePath);
+    const QSize size = reader.size();
+    const bool downscale = size.isValid() && !target.isEmpty()
+                           && (size.width() > target.width() || size.height() > target.height());
+    if (downscale)
+        reader.setScaledSize(size.scaled(target, Qt::KeepAspectRatio));
+
+    Entry entry;
+    entry.image.image = reader.read();
+    if (entry.image.image.isNull()) {
+        QMutexLocker locker(&mutex);
+        loading.remove(imagePath);
+        locker.unlock();
+        emit failed(imagePath);
+        return;
+    }
+    entry.image.labels = readYoloLabels(labelPath);
+    entry.target = target;
+    entry.fullSize = !downscale;
+    entry.bytes = qint64(entry.image.image.bytesPerLine()) * entry.image.image.height();
+
+    {
+        QMutexLocker locker(&mutex);
+        loading.remove(imagePath);
+
+        auto old = entries.find(imagePath);
+        if (old != entries.end()) {
+            totalBytes -= old->bytes;
+            recency.erase(old->position);
+            entries.erase(old);
+        }
+        recency.push_front(imagePath);
+        entry.position = recency.begin();
+        totalBytes += entry.bytes;
+        entries.insert(imagePath, entry);
+        evict();
+    }
+    emit loaded(imagePath);
+}
+
+void ImageCache::evict()
+{
+    // 가장 오래 안 쓴 것부터 (방금 넣은 항목 하나는 남김)
+    while (totalBytes > maxBytes && recency.size() > 1) {
+        auto it = entries.find(recency.back());
+        totalBytes -= it->bytes;
+        entries.erase(it);
+        recency.pop_back();
+    }
+}
+
+void ImageCache::cancelPending()
+{
+    pool.clear();
+    QMutexLocker locker(&mutex);
+    loading.clear();  // 이미 실행 중인 작업은 끝나면 그대로 저장된다
+}
+
+void ImageCache::invalidate(const QString &imagePath)
+{
+    QMutexLocker locker(&mutex);
+    auto it = entries.find(imagePath);
+    if (it == entries.end())
+        return;
+    totalBytes -= it->bytes;
+    recency.erase(it->position);
+    entries.erase(it);
+}
+
+void ImageCache::clear()
+{
+    cancelPending();
+    QMutexLocker locker(&mutex);
+    entries.clear();
+    recency.clear();
+    totalBytes = 0;
+}
@@ -0,0 +1,68 @@
+// imagecache.h
+#pragma once
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QSize>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+#include <list>
+#include "yololabel.h"
+
+// 디코딩 + 표시 크기로 축소된 이미지와 파싱된 라벨
+struct CachedImage {
+    QImage image;
+    QVector<YoloLabel> labels;
+};
+
+// 데이터셋 이미지 LRU 캐시 (메모리 상한 maxBytes).
+// 디코딩 / 라벨 파싱은 스레드 풀에서 하고, 끝나면 loaded 를 emit 한다 (GUI 스레드는 조회만)
+class ImageCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ImageCache(qint64 maxBytes = 256ll * 1024 * 1024, QObject *parent = nullptr);
+    ~ImageCache();
+
+    // target 이상 크기로 만들어 둔 항목이 있으면 true (최근 사용으로 갱신)
+    bool lookup(const QString &imagePath, const QSize &target, CachedImage &result);
+
+    // 백그라운드 디코딩 요청 (priority 가 클수록 먼저). 이미 있거나 읽는 중이면 무시
+    void request(const QString &imagePath, const QString &labelPath, const QSize &target, int priority);
+
+    // 아직 시작하지 않은 요청 취소 (탐색 방향이 바뀌었을 때 지나간 이웃은 버림)
+    void cancelPending();
+
+    void invalidate(const QString &imagePath);
+    void clear();
+
+signals:
+    void loaded(const QString &imagePath);
+    void failed(const QString &imagePath);
+
+private:
+    struct Entry {
+        CachedImage image;
+        QSize target;       // 이 크기에 맞춰 축소함
+        bool fullSize;      // 원본이 target 보다 작아서 축소하지 않음
+        qint64 bytes;
+        std::list<QString>::iterator position;
+    };
+
+    void load(const QString &imagePath, const QString &labelPath, const QSize &target);
+    bool fits(const Entry &entry, const QSize &target) const;
+    void evict();
+
+    QMutex mutex;
+    QHash<QString, Entry> entries;
+    std::list<QString> recency;   // 앞쪽이 최근
+    QSet<QString> loading;
+    qint64 maxBytes;
+    qint64 totalBytes;
+
+    QThreadPool pool;
+};
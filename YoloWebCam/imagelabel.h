@@ -3,6 +3,16 @@
 #include <QLabel>
 #include <QMouseEvent>
 #include <QPainter>
+#include <QPixmap>
+#include <QStringList>
+#include <QVector>
+
+// 원본 이미지 좌표계의 박스 하나 (검출 결과 / 라벨)
+struct OverlayBox {
+    QRectF rect;
+    QString text;
+    QColor color = Qt::red;
+};
 
 class ImageLabel : public QLabel
 {
@@ -10,11 +20,84 @@ class ImageLabel : public QLabel
 
 public:
     explicit ImageLabel(QWidget* parent = nullptr)
-        : QLabel(parent), mouseX(-1), mouseY(-1), dragging(false)
+        : QLabel(parent), mouseX(-1), mouseY(-1), dragging(false), overlayVisible(false)
     {
         setMouseTracking(true);
     }
 
+    // 라벨 크기로 축소된 프레임 + 원본 이미지 크기 (박스 좌표 변환용).
+    // 박스는 픽셀에 그려 넣지 않고 paintEvent 에서 이 위에 그린다
+    void setFrame(const QPixmap& pixmap, const QSize& sourceSize)
+    {
+        imageSize = sourceSize;
+        setPixmap(pixmap);
+    }
+
+    // 박스만 바뀌면 이전 / 새 박스가 차지하는 영역만 다시 그린다
+    void setBoxes(const QVector<OverlayBox>& newBoxes)
+    {
+        QRegion damage = boxesRegion(boxes);
+        boxes = newBoxes;
+        damage += boxesRegion(boxes);
+        if (!damage.isEmpty())
+            update(damage);
+    }
+
+    void addBox(const OverlayBox& box)
+    {
+        boxes.push_back(box);
+        update(boxesRegion(QVector<OverlayBox>(1, box)));
+    }
+
+    const QVector<OverlayBox>& overlayBoxes() const { return boxes; }
+
+    // 화면에 보이는 (비율 유지, 가운데 정렬) 프레임 영역
+    QRectF frameRect() const
+    {
+        if (imageSize.isEmpty())
+            return QRectF(contentsRect());
+        QSizeF size = QSizeF(imageSize).scaled(QSizeF(contentsRect().size()), Qt::KeepAspectRatio);
+        QRectF rect(QPointF(0, 0), size);
+        rect.moveCenter(QRectF(contentsRect()).center());
+        return rect;
+    }
+
+    QRectF imageToWidget(const QRectF& rect) const
+    {
+        if (imageSize.isEmpty())
+            return rect;
+        QRectF frame = frameRect();
+        double scale = frame.width() / imageSize.width();
+        return QRectF(frame.left() + rect.x() * scale, frame.top() + rect.y() * scale,
+                      rect.width() * scale, rect.height() * scale);
+    }
+
+    QRectF widgetToImage(const QRectF& rect) const
+    {
+        if (imageSize.isEmpty())
+            return rect;
+        QRectF frame = frameRect();
+        double scale = imageSize.width() / frame.width();
+        return QRectF((rect.x() - frame.left()) * scale, (rect.y() - frame.top()) * scale,
+                      rect.width() * scale, rect.height() * scale);
+    }
+
+    // 좌상단 HUD (지연 시간 / FPS / 큐 상태)
+    void setOverlayText(const QStringList& lines)
+    {
+        overlayLines = lines;
+        if (overlayVisible)
+            update();
+    }
+
+    void setOverlayVisible(bool visible)
+    {
+        overlayVisible = visible;
+        update();
+    }
+
+    bool isOverlayVisible() const { return overlayVisible; }
+
 signals:
     void boxCreated(QRectF box); // 🔥 드래그 끝나면 MainWindow로 알릴 신호
 
@@ -66,6 +149,19 @@ protected:
         QPainter painter(this);
         painter.setRenderHint(QPainter::Antialiasing);
 
+        // 🔥 검출 / 라벨 박스 (이미지 좌표 → 화면 좌표), 다시 그릴 영역에 걸친 것만
+        for (const OverlayBox& box : boxes) {
+            if (!event->rect().intersects(boxArea(box)))
+                continue;
+            QRectF rect = imageToWidget(box.rect);
+            painter.setPen(QPen(box.color, 2));
+            painter.drawRect(rect);
+            if (!box.text.isEmpty()) {
+                painter.setPen(Qt::green);
+                painter.drawText(rect.topLeft() + QPointF(2, 12), box.text);
+            }
+        }
+
         // 🔥 항상 그려지는 십자 구분선
         if (mouseX >= 0 && mouseY >= 0) {
             painter.setPen(QPen(QColor(150, 150, 150, 180), 1, Qt::DashLine));
@@ -79,13 +175,55 @@ protected:
             QRect rect = QRect(startPos, currentPos).normalized();
             painter.drawRect(rect);
         }
+
+        // 🔥 HUD: 반투명 배경 위에 한 줄씩
+        if (overlayVisible && !overlayLines.isEmpty()) {
+            QFont hudFont("Monospace");
+            hudFont.setStyleHint(QFont::TypeWriter);
+            painter.setFont(hudFont);
+            QFontMetrics metrics(hudFont);
+
+            int textWidth = 0;
+            for (const QString& line : overlayLines)
+                textWidth = qMax(textWidth, metrics.horizontalAdvance(line));
+            QRect hudRect(6, 6, textWidth + 12, metrics.height() * overlayLines.size() + 8);
+
+            painter.fillRect(hudRect, QColor(0, 0, 0, 160));
+            painter.setPen(Qt::white);
+            for (int i = 0; i < overlayLines.size(); ++i)
+                painter.drawText(hudRect.left() + 6, hudRect.top() + 4 + metrics.ascent() + i * metrics.height(), overlayLines[i]);
+        }
     }
 
 private:
+    // 박스 테두리 + 글자가 차지하는 화면 영역
+    QRect boxArea(const OverlayBox& box) const
+    {
+        QRect rect = imageToWidget(box.rect).toAlignedRect().adjusted(-2, -2, 2, 2);
+        if (box.text.isEmpty())
+            return rect;
+        QRect text(rect.topLeft(), QSize(fontMetrics().horizontalAdvance(box.text) + 8, fontMetrics().height() + 4));
+        return rect.united(text);
+    }
+
+    QRegion boxesRegion(const QVector<OverlayBox>& list) const
+    {
+        QRegion region;
+        for (const OverlayBox& box : list)
+            region += boxArea(box);
+        return region;
+    }
+
+    QSize imageSize;
+    QVector<OverlayBox> boxes;
+
     int mouseX;
     int mouseY;
 
     bool dragging;
     QPoint startPos;
     QPoint currentPos;
+
+    bool overlayVisible;
+    QStringList overlayLines;
 };
@@ -0,0 +1,402 @@
+// inferencepool.cpp
+#include "inferencepool.h"
+#include <algorithm>
+#include <chrono>
+#include <opencv2/core.hpp>
+#include <opencv2/dnn.hpp>
+
+InferencePool::InferencePool(const InferenceSettings &settings, QObject *parent)
+    : QObject(parent)
+    , batchSize(std::max(1, settings.batchSize))
+    , requestedBatchSize(batchSize)
+    , batchTimeoutMs(std::max(0, settings.batchTimeoutMs))
+    , trackSettings(settings.track)
+    , paused(false)
+    , pendingFrames(0)
+    , pendingSinceUs(0)
+    , virtualClock(0)
+{
+    trackSettings.detectEvery = std::max(1, trackSettings.detectEvery);
+    batchTimer.setSingleShot(true);
+    connect(&batchTimer, &QTimer::timeout, this, &InferencePool::tryDispatch);
+
+    // OpenCV 의 intra-op 스레드 수는 프로세스 전역 설정이다
+    if (settings.threadsPerWorker > 0)
+        cv::setNumThreads(settings.threadsPerWorker);
+
+    const int count = std::max(1, settings.workers);
+    workers.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        Slot slot;
+        slot.thread = new QThread();
+        slot.worker = new InferenceWorker();
+        slot.worker->moveToThread(slot.thread);
+        slot.outstanding = 0;
+        slot.worker->setResolutionBudget(settings.latencyBudgetMs, settings.minInputSize, settings.maxInputSize);
+        slot.worker->setTiling(settings.tiles);
+
+        connect(slot.worker, &InferenceWorker::inferenceCompleted, this,
+                [this, i](const FramePtr &frame, const std::vector<Detection> &detections, double time) {
+                    onWorkerCompleted(i, frame, detections, time);
+                });
+
+        slot.thread->start();
+        workers.push_back(slot);
+    }
+}
+
+InferencePool::~InferencePool()
+{
+    shutdown();
+}
+
+bool InferencePool::loadModel(const QString &path, int backend, int target)
+{
+    NetList nets;
+    bool dynamicShape = true;
+    for (size_t i = 0; i < workers.size(); ++i) {
+        cv::dnn::Net net = ModelLoader::readModel(path, backend, target, 640, nullptr, i == 0 ? &dynamicShape : nullptr);
+        if (net.empty())
+            return false;
+        nets.push_back(net);
+    }
+    setModels(nets, 640, dynamicShape);
+    return true;
+}
+
+void InferencePool::setModels(const NetList &nets, int inputSize, bool dynamicShape)
+{
+    if (nets.size() < workers.size()) {
+        qWarning("setModels: %d nets for %d workers", int(nets.size()), int(workers.size()));
+        return;
+    }
+
+    // 고정 shape 모델은 배치 1 만 받는다 (다음 dispatch 부터 적용, 다시 dynamic 모델이면 요청한 배치로)
+    batchSize = dynamicShape ? requestedBatchSize : 1;
+    if (!dynamicShape && requestedBatchSize > 1)
+        qWarning("model has a fixed batch size; batching %d frames per forward is disabled", requestedBatchSize);
+
+    // 🔥 Net 교체를 워커 스레드 이벤트 큐에 넣는다. 워커는 한 번에 배치 하나만 받으므로
+    //    이 시점까지 전달된 프레임은 이전 모델로, 이후 프레임은 새 모델로 처리된다 (forward 와 경쟁 없음)
+    for (size_t i = 0; i < workers.size(); ++i) {
+        InferenceWorker *worker = workers[i].worker;
+        cv::dnn::Net net = nets[i];
+        QMetaObject::invokeMethod(worker, [worker, net, inputSize, dynamicShape]() {
+            worker->setInputSize(inputSize);
+            worker->setModel(net, dynamicShape);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void InferencePool::setPaused(bool value)
+{
+    if (paused == value)
+        return;
+    paused = value;
+    if (paused)
+        batchTimer.stop();
+    else
+        tryDispatch();
+}
+
+void InferencePool::shutdown()
+{
+    for (Slot &slot : workers) {
+        slot.thread->quit();
+        slot.thread->wait();
+        delete slot.worker;
+        delete slot.thread;
+    }
+    workers.clear();
+    batchTimer.stop();
+    for (auto &entry : sources) {
+        entry.second.frames.clear();
+        entry.second.arrivedUs.clear();
+        entry.second.tracker.reset();
+    }
+    pendingFrames = 0;
+    inFlight.clear();
+    reorder.clear();
+}
+
+int InferencePool::idleCount() const
+{
+    int idle = 0;
+    for (const Slot &slot : workers)
+        idle += slot.outstanding == 0 ? 1 : 0;
+    return idle;
+}
+
+void InferencePool::addSource(int sourceId, const SourcePolicy &policy)
+{
+    SourceQueue &queue = sources[sourceId];
+    queue.policy = policy;
+    queue.policy.priority = std::max(1, policy.priority);
+    if (queue.policy.queueCapacity <= 0)
+        queue.policy.queueCapacity = std::max(2, batchSize);
+    queue.tracker.setSettings(trackSettings);
+}
+
+MailboxStats InferencePool::stats(int sourceId) const
+{
+    auto it = sources.find(sourceId);
+    return it != sources.end() ? it->second.counters : MailboxStats();
+}
+
+TrackerStats InferencePool::trackerStats() const
+{
+    TrackerStats total;
+    for (const auto &entry : sources) {
+        total.detected += entry.second.tracking.detected;
+        total.tracked += entry.second.tracking.tracked;
+        total.tracks += entry.second.tracking.tracks;
+    }
+    return total;
+}
+
+void InferencePool::submitFrame(const FramePtr &frame)
+{
+    if (!frame)
+        return;
+
+    if (!sources.count(frame->sourceId))
+        addSource(frame->sourceId, SourcePolicy());
+
+    SourceQueue &queue = sources[frame->sourceId];
+    counters.posted++;
+    queue.counters.posted++;
+
+    // 🔥 추적 중이면 K 프레임에 한 번 (또는 트랙이 불확실해지면) 만 검출기로,
+    //    나머지는 순서 버퍼에 넣어 앞선 검출 결과가 나온 뒤 추적기 예측으로 채운다
+    if (trackSettings.enabled && !scheduleDetection(queue, frame->sourceId)) {
+        Result &result = reorder[FrameKey(frame->sourceId, frame->sequence)];
+        result.frame = frame;
+        result.time = 0;
+        result.tracked = true;
+        flushInOrder();
+        return;
+    }
+
+    // 쉬다가 다시 들어온 소스가 밀린 몫을 한꺼번에 가져가지 않게 현재 가상 시각부터 시작
+    if (queue.frames.empty())
+        queue.virtualTime = std::max(queue.virtualTime, virtualClock);
+    const qint64 arrived = frameClockUs();
+    if (pendingFrames == 0)
+        pendingSinceUs = arrived;
+
+    queue.frames.push_back(frame);
+    queue.arrivedUs.push_back(arrived);
+    pendingFrames++;
+
+    // 소스별 대기열은 정해진 길이까지만 (latest-frame-wins)
+    while (int(queue.frames.size()) > queue.policy.queueCapacity) {
+        queue.frames.pop_front();
+        queue.arrivedUs.pop_front();
+        pendingFrames--;
+        counters.dropped++;
+        queue.counters.dropped++;
+        queue.detectNext = true;
+    }
+
+    tryDispatch();
+
+    // 버린 검출 프레임 뒤에서 기다리던 추적 프레임이 있으면 내보낸다
+    if (trackSettings.enabled)
+        flushInOrder();
+}
+
+bool InferencePool::scheduleDetection(SourceQueue &queue, int sourceId)
+{
+    queue.sinceDetection++;
+
+    // 트랙이 불확실해도 검출 프레임이 이미 대기 / 처리 중이면 그 결과를 기다린다
+    auto running = inFlight.lower_bound(FrameKey(sourceId, 0));
+    const bool waiting = !queue.frames.empty() || (running != inFlight.end() && running->first == sourceId);
+    const bool due = queue.detectNext
+                     || queue.sinceDetection >= trackSettings.detectEvery
+                     || (!waiting && queue.tracker.needsDetection());
+    if (!due)
+        return false;
+
+    queue.sinceDetection = 0;
+    queue.detectNext = false;
+    return true;
+}
+
+InferencePool::SourceQueue *InferencePool::nextSource(qint64 nowUs)
+{
+    // 🔥 최소 FPS 목표보다 늦어진 소스가 있으면 가장 많이 늦은 소스,
+    //    없으면 virtualTime 이 가장 작은 소스 (priority 가중 공정 큐)
+    SourceQueue *best = nullptr;
+    double bestLag = 0;
+    for (auto &entry : sources) {
+        SourceQueue &queue = entry.second;
+        if (queue.frames.empty())
+            continue;
+
+        double lag = 0;  // 1 이상이면 목표 간격을 넘김
+        if (queue.policy.minFps > 0)
+            lag = (nowUs - queue.lastDispatchUs) * queue.policy.minFps / 1e6;
+        if (lag < 1.0)
+            lag = 0;
+
+        if (!best || lag > bestLag || (lag == bestLag && queue.virtualTime < best->virtualTime)) {
+            best = &queue;
+            bestLag = lag;
+        }
+    }
+    return best;
+}
+
+void InferencePool::tryDispatch()
+{
+    if (paused)
+        return;   // setPaused(false) 에서 다시 시도
+
+    while (pendingFrames > 0) {
+        Slot *idle = nullptr;
+        for (Slot &slot : workers) {
+            if (slot.outstanding == 0) {
+                idle = &slot;
+                break;
+            }
+        }
+        if (!idle)
+            return;  // 워커가 끝나면 onWorkerCompleted 에서 다시 시도
+
+        // 🔥 배치가 찼거나 가장 오래된 프레임이 타임아웃만큼 기다렸으면 전달
+        const qint64 waitedMs = (frameClockUs() - pendingSinceUs) / 1000;
+        if (pendingFrames < batchSize && waitedMs < batchTimeoutMs) {
+            batchTimer.start(int(batchTimeoutMs - waitedMs));
+            return;
+        }
+
+        dispatch(*idle, std::min(batchSize, pendingFrames));
+    }
+}
+
+void InferencePool::dispatch(Slot &slot, int count)
+{
+    const qint64 now = frameClockUs();
+    FrameBatch batch;
+    batch.reserve(count);
+    while (int(batch.size()) < count) {
+        SourceQueue *queue = nextSource(now);
+        if (!queue)
+            break;
+
+        FramePtr frame = queue->frames.front();
+        queue->frames.pop_front();
+        queue->arrivedUs.pop_front();
+        pendingFrames--;
+
+        virtualClock = queue->virtualTime;
+        queue->virtualTime += 1.0 / queue->policy.priority;
+        queue->lastDispatchUs = now;
+
+        inFlight.insert(FrameKey(frame->sourceId, frame->sequence));
+        batch.push_back(frame);
+    }
+    batchTimer.stop();
+
+    // 🔥 남은 프레임이 있으면 그중 가장 오래 기다린 프레임 기준으로 타임아웃을 이어간다 (새로 시작하면 지연이 더 붙는다)
+    pendingSinceUs = now;
+    for (const auto &entry : sources) {
+        if (!entry.second.arrivedUs.empty())
+            pendingSinceUs = std::min(pendingSinceUs, entry.second.arrivedUs.front());
+    }
+
+    slot.outstanding = int(batch.size());
+    slot.worker->submitBatch(batch);
+}
+
+void InferencePool::onWorkerCompleted(int index, const FramePtr &frame, const std::vector<Detection> &detections, double time)
+{
+    if (index >= int(workers.size()))
+        return;
+
+    const FrameKey key(frame->sourceId, frame->sequence);
+    inFlight.erase(key);
+
+    // 처리 수는 결과가 돌아왔을 때 센다 (보낸 시점에 세면 처리 중인 프레임만큼 부풀려진다)
+    counters.processed++;
+    auto source = sources.find(frame->sourceId);
+    if (source != sources.end())
+        source->second.counters.processed++;
+
+    Result &result = reorder[key];
+    result.frame = frame;
+    result.detections = detections;
+    result.time = time;
+
+    // 배치의 마지막 결과가 오면 워커가 쉬는 상태가 되고, 대기 중인 프레임을 넘긴다
+    Slot &slot = workers[index];
+    if (slot.outstanding > 0 && --slot.outstanding == 0)
+        tryDispatch();
+
+    flushInOrder();
+    if (paused && slot.outstanding == 0 && idleCount() == workerCount())
+        emit drained();
+}
+
+void InferencePool::flushInOrder()
+{
+    // 소스마다 아직 처리 중인 (또는 대기열에 있는) 가장 앞 프레임보다 앞선 결과만 순서대로 내보낸다
+    std::vector<Result> ready;
+    auto it = reorder.begin();
+    while (it != reorder.end()) {
+        const int sourceId = it->first.first;
+        auto source = sources.find(sourceId);
+        if (source == sources.end()) {
+            it = reorder.erase(it);   // 모르는 소스의 결과는 버린다
+            continue;
+        }
+        SourceQueue &queue = source->second;
+        auto blocking = inFlight.lower_bound(FrameKey(sourceId, 0));
+        const bool running = blocking != inFlight.end() && blocking->first == sourceId && blocking->second < it->first.second;
+        const bool queued = !queue.frames.empty() && queue.frames.front()->sequence < it->first.second;
+        if (running || queued) {
+            it = reorder.lower_bound(FrameKey(sourceId + 1, 0));  // 이 소스의 나머지는 대기
+            continue;
+        }
+
+        // 🔥 sequence 순서대로 추적기 갱신 (검출 프레임) / 예측 (건너뛴 프레임)
+        if (trackSettings.enabled)
+            applyTracker(queue, it->second);
+
+        ready.push_back(std::move(it->second));
+        it = reorder.erase(it);
+    }
+
+    for (const Result &result : ready)
+        emit inferenceCompleted(result.frame, result.detections, result.time);
+}
+
+void InferencePool::applyTracker(SourceQueue &queue, Result &result)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<Detection> tracks;
+    if (result.tracked) {
+        queue.tracker.predict(tracks);
+        queue.tracking.tracked++;
+    } else {
+        queue.tracker.update(result.detections, tracks);
+        queue.tracking.detected++;
+    }
+
+    // 예측 박스는 화면 밖으로 나갈 수 있으므로 프레임 안으로 자른다
+    const cv::Mat &image = result.frame->image;
+    const cv::Rect2f bounds(0.f, 0.f, float(image.cols), float(image.rows));
+    result.detections.clear();
+    for (Detection det : tracks) {
+        det.box &= bounds;
+        if (det.box.area() > 0)
+            result.detections.push_back(det);
+    }
+    queue.tracking.tracks = int(result.detections.size());
+
+    // 건너뛴 프레임의 처리 시간은 추적기 예측 시간
+    if (result.tracked)
+        result.time = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
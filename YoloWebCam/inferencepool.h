@@ -0,0 +1,138 @@
+// inferencepool.h
+#pragma once
+#include <QObject>
+#include <QString>
+#include <QThread>
+#include <QTimer>
+#include <deque>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+#include "framemailbox.h"
+#include "framepool.h"
+#include "inferenceworker.h"
+#include "modelloader.h"
+#include "objecttracker.h"
+
+// 추론 풀 설정
+struct InferenceSettings {
+    int workers = 1;            // InferenceWorker 개수 (각자 Net 인스턴스 + 스레드)
+    int threadsPerWorker = 0;   // cv::setNumThreads 값 (0 이면 OpenCV 기본값)
+    int batchSize = 1;          // 한 번의 forward 에 넣을 최대 프레임 수
+    int batchTimeoutMs = 0;     // 배치가 다 차지 않아도 가장 오래된 프레임이 이만큼 기다리면 보낸다
+    double latencyBudgetMs = 0; // 프레임당 forward 지연 시간 예산, 0 보다 크면 입력 크기를 minInputSize ~ maxInputSize 에서 자동 조절
+    int minInputSize = 320;
+    int maxInputSize = 1280;
+    TileSettings tiles;         // 고해상도 프레임 타일 추론 (작은 물체용)
+    TrackSettings track;        // 검출기는 K 프레임마다, 사이 프레임은 소스별 추적기 예측으로
+    QString modelPath;          // MainWindow 가 시작하면서 백그라운드로 로드 (비어 있으면 마지막으로 고른 모델)
+    ModelConfig model;          // 백엔드 / 타깃 / 입력 크기 (또는 autotune)
+};
+
+// 소스별 스케줄링 정책
+struct SourcePolicy {
+    int priority = 1;        // 여러 소스가 밀려 있을 때 priority 에 비례해 추론 기회를 나눈다
+    double minFps = 0;       // 추론 FPS 가 이 아래로 떨어지면 다른 소스보다 먼저 처리
+    int queueCapacity = 0;   // 소스별 대기열 길이, 넘치면 그 소스의 가장 오래된 프레임 드롭 (0 이면 max(2, batchSize))
+};
+
+// N 개의 InferenceWorker 에 프레임(배치)을 나눠 주고, 결과는 소스마다 sequence 순서대로 내보낸다.
+// 소스마다 제한된 대기열을 두고, 가중 공정 큐 (+ 최소 FPS 보장) 로 다음 프레임을 고른다.
+// 추적을 켜면 검출기를 건너뛴 프레임도 같은 순서 버퍼를 거쳐, 소스마다 sequence 순서로 추적기를 갱신 / 예측한 결과를 내보낸다.
+// 상태는 모두 GUI(소유) 스레드에서만 접근하므로 락이 필요 없다.
+class InferencePool : public QObject
+{
+    Q_OBJECT
+public:
+    explicit InferencePool(const InferenceSettings &settings = InferenceSettings(), QObject *parent = nullptr);
+    ~InferencePool();
+
+    // 워커마다 같은 ONNX 파일로 Net 을 따로 만든다 (동기, 벤치마크용)
+    bool loadModel(const QString &path, int backend, int target);
+
+    // 워커마다 준비된 Net 으로 교체 (워커 수만큼, Net 은 워커끼리 공유하지 않는다).
+    // 교체는 각 워커 스레드에서 처리 중인 배치가 끝난 뒤에 일어나고, 이전 Net 은 그때 해제된다.
+    // dynamicShape 가 false 인 (고정 shape) 모델이면 그 모델을 쓰는 동안 배치를 1 로 줄인다
+    void setModels(const NetList &nets, int inputSize = 640, bool dynamicShape = true);
+
+    // 등록하지 않은 소스는 첫 프레임이 올 때 기본 정책으로 추가된다
+    void addSource(int sourceId, const SourcePolicy &policy);
+
+    // 소스 대기열에 넣고, 쉬는 워커가 있고 배치가 찼으면 (또는 타임아웃) 바로 전달
+    void submitFrame(const FramePtr &frame);
+
+    // 멈추면 새 배치를 보내지 않는다 (프레임은 소스 대기열에서 평소처럼 밀려난다).
+    // 처리 중인 배치가 모두 끝나면 drained(). autotune 처럼 프로세스 전역 설정을 바꾸는 동안 사용
+    void setPaused(bool paused);
+    bool isPaused() const { return paused; }
+
+    void shutdown();
+
+    int workerCount() const { return int(workers.size()); }
+    int idleCount() const;
+    int inputSize() const { return workers.empty() ? 0 : workers.front().worker->inputSize(); }
+    int pendingCount() const { return pendingFrames + int(inFlight.size()); }
+    MailboxStats stats() const { return counters; }
+    MailboxStats stats(int sourceId) const;
+    bool isTracking() const { return trackSettings.enabled; }
+    int detectEvery() const { return trackSettings.detectEvery; }
+    TrackerStats trackerStats() const;
+
+signals:
+    void inferenceCompleted(const FramePtr &frame, const std::vector<Detection> &detections, const double time);
+    void drained();
+
+private:
+    struct Slot {
+        QThread *thread;
+        InferenceWorker *worker;
+        int outstanding;        // 아직 결과가 안 온 프레임 수 (0 이면 쉬는 중)
+    };
+
+    struct SourceQueue {
+        SourcePolicy policy;
+        std::deque<FramePtr> frames;
+        std::deque<qint64> arrivedUs;    // frames 와 같은 순서, 풀에 들어온 시각 (배치 타임아웃 기준)
+        double virtualTime = 0;      // 처리한 프레임마다 1 / priority 씩 증가 (작을수록 먼저)
+        qint64 lastDispatchUs = 0;
+        MailboxStats counters;
+        ObjectTracker tracker;
+        int sinceDetection = 0;      // 마지막으로 검출기에 보낸 뒤 들어온 프레임 수
+        bool detectNext = true;      // 검출 프레임이 대기열에서 버려졌거나 처음이면 다음 프레임은 바로 검출
+        TrackerStats tracking;
+    };
+
+    typedef std::pair<int, quint64> FrameKey;   // (sourceId, sequence)
+
+    struct Result {
+        FramePtr frame;
+        std::vector<Detection> detections;
+        double time;
+        bool tracked = false;   // 검출기를 건너뛰고 추적기 예측으로 채울 프레임
+    };
+
+    SourceQueue *nextSource(qint64 nowUs);
+    bool scheduleDetection(SourceQueue &queue, int sourceId);
+    void applyTracker(SourceQueue &queue, Result &result);
+    void tryDispatch();
+    void dispatch(Slot &slot, int count);
+    void onWorkerCompleted(int index, const FramePtr &frame, const std::vector<Detection> &detections, double time);
+    void flushInOrder();
+
+    int batchSize;            // 지금 쓰는 배치 크기 (고정 shape 모델이면 1)
+    int requestedBatchSize;   // --batch 로 요청한 배치 크기
+    int batchTimeoutMs;
+    TrackSettings trackSettings;
+    QTimer batchTimer;
+    bool paused;
+
+    std::vector<Slot> workers;
+    std::map<int, SourceQueue> sources;
+    int pendingFrames;                   // 모든 소스 대기열의 프레임 수
+    qint64 pendingSinceUs;               // 대기 중인 가장 오래된 프레임이 들어온 시각
+    double virtualClock;                 // 마지막으로 전달한 프레임의 virtualTime
+    std::set<FrameKey> inFlight;         // 워커에서 처리 중인 프레임
+    std::map<FrameKey, Result> reorder;  // 먼저 끝났지만 같은 소스의 앞 프레임을 기다리는 결과
+    MailboxStats counters;
+};
@@ -1,31 +1,149 @@
 // inferenceworker.cpp
 #include "inferenceworker.h"
-#include <QImage>
+#include "tracing.h"
 #include <chrono>
 
-InferenceWorker::InferenceWorker(QObject *parent) : QObject(parent) {}
+InferenceWorker::InferenceWorker(QObject *parent) : QObject(parent), scheduled(false), tiler(detector), currentInputSize(detector.inputSize()) {}
 
-void InferenceWorker::setModel(cv::dnn::Net model) {
-    net = model;
+void InferenceWorker::setModel(cv::dnn::Net model, bool dynamicShape) {
+    detector.setModel(model, dynamicShape);
 }
 
-void InferenceWorker::processFrame(const cv::Mat &frame) {
+void InferenceWorker::setInputSize(int size) {
+    resolution.reset(size);
+    detector.setInputSize(resolution.inputSize());
+    currentInputSize.store(detector.inputSize());
+}
+
+void InferenceWorker::setResolutionBudget(double budgetMs, int minSize, int maxSize) {
+    resolution.configure(budgetMs, minSize, maxSize);
+    setInputSize(detector.inputSize());
+}
+
+void InferenceWorker::submitFrame(const FramePtr &frame) {
+    submitBatch(FrameBatch(1, frame));
+}
+
+void InferenceWorker::submitBatch(const FrameBatch &batch) {
+    mailbox.post(batch);
+
+    // 이미 처리 요청이 걸려 있으면 새로 쌓지 않는다 (큐 길이 최대 1)
+    if (!scheduled.exchange(true))
+        QMetaObject::invokeMethod(this, "processPending", Qt::QueuedConnection);
+}
+
+void InferenceWorker::processPending() {
+    scheduled.store(false);
+
+    FrameBatch batch;
+    if (mailbox.take(batch))
+        processBatch(batch);
+}
+
+void InferenceWorker::processFrame(const FramePtr &framePtr) {
+    processBatch(FrameBatch(1, framePtr));
+}
 
-    if (frame.empty()) return;
+void InferenceWorker::processBatch(const FrameBatch &batch) {
+
+    // 빈 프레임은 검출 없이 바로 돌려주고 나머지만 한 배치로
+    FrameBatch frames;
+    frames.reserve(batch.size());
+    for (const FramePtr &frame : batch) {
+        if (!frame) continue;
+        if (frame->image.empty())
+            emit inferenceCompleted(frame, std::vector<Detection>(), 0.0);
+        else
+            frames.push_back(frame);
+    }
+    if (frames.empty()) return;
+
+    if (tiler.settings().enabled) {
+        processTiled(frames);
+        return;
+    }
+
+    const int count = int(frames.size());
+    const quint64 frameId = frames.front()->sequence;
+    TRACE_THREAD_NAME("inference");
+    TRACE_SCOPE("inference.processBatch", frameId);
 
     auto start = std::chrono::high_resolution_clock::now();
 
-    cv::Mat blob = cv::dnn::blobFromImage(frame, 1/255.0, cv::Size(640, 640), cv::Scalar(), true, false);
-    net.setInput(blob);
+    // 🔥 장마다 레터박스 + 정규화 + BGR→RGB + NCHW 를 배치 버퍼의 자기 슬롯에 한 번에
+    {
+        TRACE_SCOPE("inference.preprocess", frameId);
+        detector.reserve(count);
+        letterboxes.resize(count);
+        for (int i = 0; i < count; ++i)
+            letterboxes[i] = detector.prepare(i, frames[i]->image);
+    }
+
+    // 🔥 (N, 4+nc, anchors) forward 1회 + 장별 디코딩 / NMS
+    double forwardMs = 0;
+    bool forwarded = true;
+    {
+        TRACE_SCOPE("inference.forward", frameId);
+        auto forwardStart = std::chrono::high_resolution_clock::now();
+        try {
+            detector.run(count, results);
+        } catch (const cv::Exception &e) {
+            // 슬롯 안에서 예외가 나가면 Qt 가 종료된다. 검출 없이 돌려줘야 풀의 outstanding 도 줄어든다
+            qWarning("inference forward failed: %s", e.what());
+            results.assign(count, std::vector<Detection>());
+            forwarded = false;
+        }
+        forwardMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - forwardStart).count();
+    }
+
+    // 네트워크 입력 좌표 → 원본 프레임 좌표
+    {
+        TRACE_SCOPE("inference.postprocess", frameId);
+        for (int i = 0; i < count; ++i) {
+            const cv::Mat &image = frames[i]->image;
+            const cv::Rect2f bounds(0.f, 0.f, float(image.cols), float(image.rows));
+            for (Detection &det : results[i]) {
+                det.box = letterboxes[i].toSource(det.box) & bounds;
+            }
+        }
+    }
+
+    // 🔥 예산은 프레임당 시간: 배치 forward 시간을 장 수로 나눠 비교한다
+    //    계속 넘기면 다음 배치부터 작은 입력, 여유가 충분하면 큰 입력 (이번 배치 좌표는 이미 원본 기준)
+    //    고정 shape 모델은 입력 크기를 바꿀 수 없으므로 그대로
+    const int nextSize = forwarded && detector.isDynamic() ? resolution.update(forwardMs / count) : detector.inputSize();
+    if (nextSize != detector.inputSize()) {
+        detector.setInputSize(nextSize);
+        currentInputSize.store(nextSize);
+    }
 
-    std::vector<cv::Mat> outputs;
-    net.forward(outputs, net.getUnconnectedOutLayersNames());
+    auto end = std::chrono::high_resolution_clock::now();
+    double durationMs = std::chrono::duration<double, std::milli>(end - start).count();
+    for (int i = 0; i < count; ++i)
+        emit inferenceCompleted(frames[i], results[i], durationMs);  // 🔥 같은 프레임 버퍼 + 처리 시간 전달
+}
+
+void InferenceWorker::processTiled(const FrameBatch &frames) {
+    const quint64 frameId = frames.front()->sequence;
+    TRACE_THREAD_NAME("inference");
+    TRACE_SCOPE("inference.processTiled", frameId);
+
+    auto start = std::chrono::high_resolution_clock::now();
 
-    qDebug("InferenceWorker::processFrame: %d", outputs.size());
-    // 단순히 원본을 전달 (여기선 바운딩 박스 처리 생략)
-    QImage result(frame.data, frame.cols, frame.rows, frame.step, QImage::Format_RGB888);
+    // 🔥 프레임마다 겹치는 타일 (+ 전체 프레임) 을 한 배치로 forward → 원본 좌표로 옮겨 타일 간 병합
+    const int count = int(frames.size());
+    results.resize(count);
+    for (int i = 0; i < count; ++i) {
+        try {
+            tiler.detect(frames[i]->image, results[i]);
+        } catch (const cv::Exception &e) {
+            qWarning("tiled inference failed: %s", e.what());
+            results[i].clear();
+        }
+    }
 
     auto end = std::chrono::high_resolution_clock::now();
     double durationMs = std::chrono::duration<double, std::milli>(end - start).count();
-    emit inferenceCompleted(result.rgbSwapped(), durationMs);  // 🔥 처리 시간 전달
+    for (int i = 0; i < count; ++i)
+        emit inferenceCompleted(frames[i], results[i], durationMs);
 }
@@ -1,18 +1,54 @@
 // inferenceworker.h
 #pragma once
 #include <QObject>
+#include <QImage>
+#include <atomic>
+#include <vector>
 #include <opencv2/opencv.hpp>
 #include <opencv2/dnn.hpp>
+#include "batchdetector.h"
+#include "framemailbox.h"
+#include "framepool.h"
+#include "resolutioncontroller.h"
+#include "tileddetector.h"
+
+typedef std::vector<FramePtr> FrameBatch;
 
 class InferenceWorker : public QObject {
     Q_OBJECT
 public:
     explicit InferenceWorker(QObject *parent = nullptr);
-    void setModel(cv::dnn::Net net);
+    // 워커 스레드에서만 호출 (InferencePool::setModels)
+    void setModel(cv::dnn::Net net, bool dynamicShape = true);
+    void setInputSize(int size);
+
+    // 지연 시간 예산 기반 입력 크기 조절 (스레드 시작 전에 호출, budgetMs <= 0 이면 고정 크기)
+    void setResolutionBudget(double budgetMs, int minSize, int maxSize);
+    int inputSize() const { return currentInputSize.load(); }
+
+    // 타일 추론 모드 (스레드 시작 전에 호출). 켜면 입력 크기 자동 조절은 쓰지 않는다
+    void setTiling(const TileSettings &settings) { tiler.setSettings(settings); }
+
+    // GUI 스레드에서 호출. 최신 프레임(배치)만 메일박스에 남기고 처리 요청은 최대 1개만 큐에 쌓는다
+    void submitFrame(const FramePtr &frame);
+    void submitBatch(const FrameBatch &batch);
+    MailboxStats mailboxStats() const { return mailbox.stats(); }
 public slots:
-    void processFrame(const cv::Mat &frame); // 외부에서 호출
+    void processFrame(const FramePtr &frame); // 외부에서 호출
+    void processPending();                   // 메일박스의 최신 배치 처리
 signals:
-    void inferenceCompleted(const QImage &image, const double time);
+    // 배치로 처리해도 프레임마다 한 번씩 emit (time 은 배치 전체 처리 시간)
+    void inferenceCompleted(const FramePtr &frame, const std::vector<Detection> &detections, const double time);
 private:
-    cv::dnn::Net net;
+    void processBatch(const FrameBatch &batch);
+    void processTiled(const FrameBatch &frames);
+
+    FrameMailbox<FrameBatch> mailbox;
+    std::atomic<bool> scheduled;
+    BatchDetector detector;
+    TiledDetector tiler;
+    std::vector<LetterboxInfo> letterboxes;
+    std::vector<std::vector<Detection>> results;
+    ResolutionController resolution;
+    std::atomic<int> currentInputSize;
 };
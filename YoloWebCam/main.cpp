@@ -1,15 +1,148 @@
 #include "mainwindow.h"
+#include "framesource.h"
+#include "framepool.h"
+#include "modelloader.h"
+#include "yolodecoder.h"
 
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QMetaType>
+#include <QVector>
 #include <opencv2/core.hpp>
 
 int main(int argc, char *argv[])
 {
     qRegisterMetaType<cv::Mat>("cv::Mat");
+    qRegisterMetaType<std::vector<Detection>>("std::vector<Detection>");
+    qRegisterMetaType<FramePtr>("FramePtr");
+    qRegisterMetaType<NetList>("NetList");
+    qRegisterMetaType<ModelConfig>("ModelConfig");
 
     QApplication a(argc, argv);
-    MainWindow w;
+
+    // 캡처 장치 옵션 (예: --width 1280 --height 720 --fps 60 --format MJPG --decode-scale 2)
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption deviceOption("device", "V4L2 camera index.", "index", "0");
+    QCommandLineOption widthOption("width", "Capture width.", "pixels", "0");
+    QCommandLineOption heightOption("height", "Capture height.", "pixels", "0");
+    QCommandLineOption fpsOption("fps", "Capture frame rate.", "fps", "0");
+    QCommandLineOption formatOption("format", "Pixel format (MJPG or YUYV).", "fourcc");
+    QCommandLineOption decodeScaleOption("decode-scale", "MJPG reduced decode scale (1, 2, 4, 8).", "scale", "1");
+    QCommandLineOption modelOption("model", "ONNX model, loaded in the background (default: last model picked).", "path");
+    QCommandLineOption backendOption("backend", "Inference backend: cuda, cpu or auto (benchmark once, then cached).", "backend", "cuda");
+    QCommandLineOption tuneSizesOption("tune-sizes", "Input sizes compared by --backend auto, e.g. 640,512,416.", "sizes", "640");
+    QCommandLineOption retuneOption("retune", "Ignore the cached --backend auto result and benchmark again.");
+    QCommandLineOption latencyBudgetOption("latency-budget", "Adapt the model input size (320-1280) to keep per-frame forward time under this budget.", "ms", "0");
+    QCommandLineOption minInputOption("min-input", "Smallest adaptive input size.", "pixels", "320");
+    QCommandLineOption maxInputOption("max-input", "Largest adaptive input size.", "pixels", "1280");
+    QCommandLineOption tilesOption("tiles", "Tiled inference: overlapping tiles at full resolution (small objects on 1080p/4K).");
+    QCommandLineOption tileSizeOption("tile-size", "Tile size in source pixels.", "pixels", "640");
+    QCommandLineOption tileOverlapOption("tile-overlap", "Overlap between neighbouring tiles (0-0.9).", "ratio", "0.2");
+    QCommandLineOption tileBatchOption("tile-batch", "Tiles per forward pass (0 = all tiles of a frame at once, dynamic-batch model).", "count", "1");
+    QCommandLineOption noGlobalPassOption("no-global-pass", "Tiled inference without the extra whole-frame pass.");
+    QCommandLineOption detectEveryOption("detect-every", "Run the detector every K frames and track objects in between (1 = every frame).", "K", "1");
+    QCommandLineOption trackOption("track", "Track objects across frames and show stable track IDs (implied by --detect-every > 1).");
+    QCommandLineOption workersOption("workers", "Number of inference workers.", "count", "1");
+    QCommandLineOption threadsOption("threads", "OpenCV threads per inference worker (0 = default).", "count", "0");
+    QCommandLineOption batchOption("batch", "Frames per forward pass (dynamic-batch model).", "count", "1");
+    QCommandLineOption batchTimeoutOption("batch-timeout", "Max wait for a batch to fill.", "ms", "0");
+    QCommandLineOption sourceOption("source",
+        "Input source, repeatable: device index, video file or image folder "
+        "with optional ,priority=N,min-fps=F,queue=N.", "spec");
+    QCommandLineOption replayOption("replay", "File/folder replay: recorded (timestamps) or fast (lossless, max speed).", "mode", "recorded");
+    QCommandLineOption loopOption("loop", "Replay count for file/folder sources (0 = forever).", "count", "0");
+    QCommandLineOption startOffsetOption("start-offset", "Skip file/folder frames before this time.", "ms", "0");
+    QCommandLineOption replayInFlightOption("replay-in-flight", "Fast replay: max frames of a source in the pipeline at once.", "count", "4");
+    QCommandLineOption captureFormatOption("capture-format", "Captured image format (jpg or png).", "format", "jpg");
+    QCommandLineOption captureQualityOption("capture-quality", "JPEG quality, 0-100.", "quality", "95");
+    QCommandLineOption capturePngLevelOption("capture-png-level", "PNG compression level, 0 (none) to 9 (smallest, slowest).", "level", "3");
+    QCommandLineOption captureWorkersOption("capture-workers", "Capture encoder threads.", "count", "2");
+    QCommandLineOption burstEveryOption("burst-every", "Burst capture (F3): save every Nth frame (0 = use --burst-fps).", "frames", "0");
+    QCommandLineOption burstFpsOption("burst-fps", "Burst capture: max frames saved per second.", "fps", "5");
+    QCommandLineOption burstSecondsOption("burst-seconds", "Burst capture length (0 = until F3 again).", "seconds", "10");
+    QCommandLineOption recordContentOption("record-content", "Recording (F4): annotated or raw frames.", "content", "annotated");
+    QCommandLineOption recordPolicyOption("record-policy", "Recording queue overflow: drop (never stalls live video) or block (lossless).", "policy", "drop");
+    QCommandLineOption recordQueueOption("record-queue", "Recording queue length in frames.", "count", "32");
+    QCommandLineOption recordFourccOption("record-fourcc", "Recording codec.", "fourcc", "MJPG");
+    QCommandLineOption recordFpsOption("record-fps", "Recording container frame rate.", "fps", "30");
+    QCommandLineOption recordDirOption("record-dir", "Recording output folder (default: working directory).", "path");
+    QCommandLineOption exitOption("exit-on-finish", "Print pipeline stats and quit when all file/folder sources have finished (cameras are not waited for).");
+    parser.addOptions({ sourceOption, replayOption, loopOption, startOffsetOption, replayInFlightOption, exitOption, deviceOption, widthOption, heightOption, fpsOption, formatOption, decodeScaleOption,
+                        modelOption, backendOption, tuneSizesOption, retuneOption, latencyBudgetOption, minInputOption, maxInputOption,
+                        tilesOption, tileSizeOption, tileOverlapOption, tileBatchOption, noGlobalPassOption, detectEveryOption, trackOption, workersOption, threadsOption, batchOption, batchTimeoutOption,
+                        captureFormatOption, captureQualityOption, capturePngLevelOption, captureWorkersOption, burstEveryOption, burstFpsOption, burstSecondsOption,
+                        recordContentOption, recordPolicyOption, recordQueueOption, recordFourccOption, recordFpsOption, recordDirOption });
+    parser.process(a);
+
+    CaptureSettings capture;
+    capture.device = parser.value(deviceOption).toInt();
+    capture.width = parser.value(widthOption).toInt();
+    capture.height = parser.value(heightOption).toInt();
+    capture.fps = parser.value(fpsOption).toInt();
+    capture.pixelFormat = parser.value(formatOption).toUpper();
+    capture.decodeScale = parser.value(decodeScaleOption).toInt();
+
+    InferenceSettings inference;
+    inference.workers = parser.value(workersOption).toInt();
+    inference.threadsPerWorker = parser.value(threadsOption).toInt();
+    inference.batchSize = parser.value(batchOption).toInt();
+    inference.batchTimeoutMs = parser.value(batchTimeoutOption).toInt();
+    inference.modelPath = parser.value(modelOption);
+    inference.tiles.enabled = parser.isSet(tilesOption);
+    inference.tiles.tileSize = parser.value(tileSizeOption).toInt();
+    inference.tiles.overlap = parser.value(tileOverlapOption).toDouble();
+    inference.tiles.tilesPerForward = parser.value(tileBatchOption).toInt();
+    inference.tiles.globalPass = !parser.isSet(noGlobalPassOption);
+    inference.track.detectEvery = parser.value(detectEveryOption).toInt();
+    inference.track.enabled = parser.isSet(trackOption) || inference.track.detectEvery > 1;
+    inference.latencyBudgetMs = parser.value(latencyBudgetOption).toDouble();
+    inference.minInputSize = parser.value(minInputOption).toInt();
+    inference.maxInputSize = parser.value(maxInputOption).toInt();
+    if (parser.value(backendOption) == "cpu") {
+        inference.model.backend = cv::dnn::DNN_BACKEND_OPENCV;
+        inference.model.target = cv::dnn::DNN_TARGET_CPU;
+    } else if (parser.value(backendOption) == "auto") {
+        inference.model.backend = ModelConfig::AutoBackend;
+        inference.model.tuneInputSizes.clear();
+        for (const QString &size : parser.value(tuneSizesOption).split(',', QString::SkipEmptyParts))
+            if (size.toInt() >= 32)
+                inference.model.tuneInputSizes.push_back(size.toInt() / 32 * 32);  // stride 32 배수
+        if (inference.model.tuneInputSizes.isEmpty())
+            inference.model.tuneInputSizes.push_back(640);
+        inference.model.retune = parser.isSet(retuneOption);
+    }
+
+    EncodeSettings encode;
+    encode.format = parser.value(captureFormatOption);
+    encode.quality = parser.value(captureQualityOption).toInt();
+    encode.pngLevel = parser.value(capturePngLevelOption).toInt();
+    encode.workers = parser.value(captureWorkersOption).toInt();
+    encode.burst.everyNth = parser.value(burstEveryOption).toInt();
+    encode.burst.maxFps = parser.value(burstFpsOption).toDouble();
+    encode.burst.durationSec = parser.value(burstSecondsOption).toInt();
+
+    RecordSettings record;
+    record.content = parser.value(recordContentOption) == "raw" ? RecordSettings::Raw : RecordSettings::Annotated;
+    record.overflow = parser.value(recordPolicyOption) == "block" ? RecordSettings::Block : RecordSettings::Drop;
+    record.queueCapacity = parser.value(recordQueueOption).toInt();
+    record.fourcc = parser.value(recordFourccOption).toUpper();
+    record.fps = parser.value(recordFpsOption).toDouble();
+    record.directory = parser.value(recordDirOption);
+
+    // 파일 / 폴더 소스 기본 재생 방식 (소스별로 ,mode=fast,loop=1,offset=0,in-flight=4 로 덮어쓰기 가능)
+    SourceSettings sourceDefaults;
+    sourceDefaults.replay.mode = parser.value(replayOption) == "fast" ? ReplaySettings::Fast : ReplaySettings::Recorded;
+    sourceDefaults.replay.loops = parser.value(loopOption).toInt();
+    sourceDefaults.replay.startOffsetMs = parser.value(startOffsetOption).toLongLong();
+    sourceDefaults.replay.maxInFlight = qMax(1, parser.value(replayInFlightOption).toInt());
+
+    QVector<SourceSettings> sources;
+    for (const QString &spec : parser.values(sourceOption))
+        sources.push_back(parseSourceSpec(spec, sourceDefaults));
+
+    MainWindow w(capture, inference, sources, encode, record);
+    w.setExitWhenFinished(parser.isSet(exitOption));
     w.show();
     return a.exec();
 }
@@ -1,7 +1,22 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
+#include "annotationstore.h"
+#include "autotuner.h"
+#include "captureencoder.h"
+#include "datasetmodel.h"
+#include "displayscaler.h"
+#include "imagecache.h"
 #include "imagelabel.h"
-
+#include "modelloader.h"
+#include "streamrecorder.h"
+#include "tracing.h"
+#include "videogrid.h"
+#include "yololabel.h"
+
+#include <QApplication>
+#include <QGuiApplication>
+#include <QScreen>
+#include <QSettings>
 #include <QTimer>
 #include <QImage>
 #include <QPixmap>
@@ -15,128 +30,529 @@
 #include <QPen>
 #include <QTextStream>
 #include <QKeyEvent>
+#include <QAction>
+#include <QVBoxLayout>
 #include <QFile>
 #include <QTextStream>
 #include <QRegularExpression>
 #include <opencv2/opencv.hpp>
 #include <opencv2/dnn.hpp>
 
-cv::dnn::Net net;
 int currentTabIndex = 0;  // 0: Train, 1: Val
 
-MainWindow::MainWindow(QWidget *parent)
+MainWindow::MainWindow(const CaptureSettings &capture, const InferenceSettings &inference,
+                       const QVector<SourceSettings> &sourceList, const EncodeSettings &encode,
+                       const RecordSettings &record, QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
 {
     ui->setupUi(this);
     setupImageLabel();
+    TRACE_THREAD_NAME("gui");
     ui->videoLabel->setSizePolicy(QSizePolicy::Ignored, QSizePolicy::Ignored);
 
-    // 웹캠 Thread
-    webcamWorker = new WebcamWorker();
-    workerThread = new QThread();
-    webcamWorker->moveToThread(workerThread);
-
-    // 네트워크 Thread
-    inferenceThread = new QThread(this);
-    inferenceWorker = new InferenceWorker();
-    inferenceWorker->moveToThread(inferenceThread);
-
-    connect(workerThread, &QThread::started, webcamWorker, &WebcamWorker::start);
-    connect(webcamWorker, &WebcamWorker::frameReady, this, &MainWindow::updateFrame);
-    connect(inferenceWorker, &InferenceWorker::inferenceCompleted, this, &MainWindow::onInferenceCompleted);
-    connect(this, &MainWindow::destroyed, this, &MainWindow::cleanupWorker);
-    connect(ui->fileListWidget, &QListWidget::itemClicked, this, &MainWindow::on_fileItemClicked);
+    // 표시 Thread (라벨 크기로 축소 전용)
+    displayScaler = new DisplayScaler();
+    displayThread = new QThread();
+    displayScaler->moveToThread(displayThread);
+    connect(this, &MainWindow::displayRequested, displayScaler, &DisplayScaler::scale);
+    connect(displayScaler, &DisplayScaler::scaled, this, &MainWindow::onDisplayScaled);
+    displayThread->start();
+
+    // 🔥 화면 주사율에 맞춰 표시 (그 사이에 온 프레임은 최신 것만 남김)
+    QScreen* screen = QGuiApplication::primaryScreen();
+    const double refreshRate = screen && screen->refreshRate() >= 1.0 ? screen->refreshRate() : 60.0;
+    displayTimer.setTimerType(Qt::PreciseTimer);
+    displayTimer.setInterval(qMax(1, int(1000.0 / refreshRate)));
+    connect(&displayTimer, &QTimer::timeout, this, &MainWindow::onDisplayTick);
+    displayTimer.start();
+
+    // 네트워크 Thread (워커 풀)
+    inferencePool = new InferencePool(inference, this);
+
+    // 입력 소스 Thread (지정이 없으면 --device 웹캠 하나)
+    QVector<SourceSettings> sourceSettings = sourceList;
+    if (sourceSettings.isEmpty())
+        sourceSettings.push_back(SourceSettings());
+
+    for (int id = 0; id < sourceSettings.size(); ++id) {
+        SourceSlot slot;
+        slot.source = createFrameSource(id, sourceSettings[id], capture);
+        slot.thread = new QThread();
+        slot.source->moveToThread(slot.thread);
+        connect(slot.thread, &QThread::started, slot.source, &FrameSource::start);
+        connect(slot.source, &FrameSource::frameReady, this, &MainWindow::updateFrame);
+        connect(slot.source, &FrameSource::finished, this, &MainWindow::onSourceFinished);
+        sources.push_back(slot);
+
+        SourcePolicy policy;
+        policy.priority = sourceSettings[id].priority;
+        policy.minFps = sourceSettings[id].minFps;
+        policy.queueCapacity = sourceSettings[id].queueCapacity;
+        if (sourceSettings[id].replay.mode == ReplaySettings::Fast)  // fast 재생은 대기열에서 드롭되지 않게
+            policy.queueCapacity = qMax(policy.queueCapacity, sourceSettings[id].replay.maxInFlight);
+        inferencePool->addSource(id, policy);
+    }
+    if (sources.size() > 1)
+        setupVideoGrid();
+
+    connect(inferencePool, &InferencePool::inferenceCompleted, this, &MainWindow::onInferenceCompleted);
+    // 파일 목록: 백그라운드 인덱스 + 스크롤하는 만큼만 행 생성
+    datasetModel = new DatasetModel(this);
+    ui->fileListView->setModel(datasetModel);
+    connect(ui->fileListView, &QListView::clicked, this, &MainWindow::on_fileItemClicked);
+    connect(datasetModel, &DatasetModel::countChanged, this, &MainWindow::updateImageInfo);
+
+    // 데이터셋 이미지 캐시: 디코딩은 스레드 풀에서, 다 되면 GUI 스레드로 알림
+    imageCache = new ImageCache(256ll * 1024 * 1024, this);
+    connect(imageCache, &ImageCache::loaded, this, &MainWindow::onCachedImageLoaded);
+    connect(imageCache, &ImageCache::failed, this, &MainWindow::onCachedImageFailed);
+
+    // 캡처 저장: 공유 프레임 버퍼를 인코딩 스레드 풀로 (GUI 스레드에서는 파일 I/O 없음)
+    captureEncoder = new CaptureEncoder(encode, this);
+    connect(captureEncoder, &CaptureEncoder::frameSaved, this, &MainWindow::onCaptureSaved);
+    connect(captureEncoder, &CaptureEncoder::saveFailed, this, [](const QString& path) {
+        qWarning("Failed to save image: %s", qPrintable(path));
+    });
+    connect(captureEncoder, &CaptureEncoder::burstFinished, this, [this](int savedFrames, int droppedFrames) {
+        ui->statusbar->showMessage(QString("Burst capture finished: %1 saved, %2 dropped").arg(savedFrames).arg(droppedFrames));
+    });
+
+    // 스트림 녹화: 인코딩은 녹화 스레드에서, 여기서는 대기열에 넣기만
+    recorder = new StreamRecorder(record, this);
+    connect(recorder, &StreamRecorder::finished, this, [this](const QString& path, quint64 recordedFrames, quint64 droppedFrames) {
+        ui->statusbar->showMessage(QString("Recording saved: %1 (%2 frames, %3 dropped)").arg(path).arg(recordedFrames).arg(droppedFrames));
+    });
+    connect(recorder, &StreamRecorder::failed, this, [](const QString& path) {
+        qWarning("Failed to open video writer: %s", qPrintable(path));
+    });
+
+    // 라벨은 메모리에서 편집하고 (undo / redo), 파일 저장은 모아서 쓰기 스레드에서
+    annotations = new AnnotationStore(this);
+    connect(annotations, &AnnotationStore::labelsChanged, this, &MainWindow::onLabelsChanged);
+    connect(annotations, &AnnotationStore::writeFailed, this, [this](const QString& labelPath) {
+        ui->statusbar->showMessage("Failed to save labels: " + labelPath);
+    });
+    QAction* undoAction = annotations->undoStack()->createUndoAction(this, "되돌리기");
+    undoAction->setShortcuts(QKeySequence::Undo);
+    QAction* redoAction = annotations->undoStack()->createRedoAction(this, "다시 실행");
+    redoAction->setShortcuts(QKeySequence::Redo);
+    ui->menu->addSeparator();
+    ui->menu->addAction(undoAction);
+    ui->menu->addAction(redoAction);
     connect(ui->tabWidget, &QTabWidget::currentChanged, this, &MainWindow::on_tabWidget_currentChanged);
     connect(ui->actionSetPath, &QAction::triggered, this, &MainWindow::openFolder);
+
+    // 모델 로드 Thread: 읽기 + 백엔드 준비 + 워밍업이 끝나면 추론 워커에 넘긴다 (그동안 카메라는 원본 표시)
+    modelConfig = inference.model;
+    modelLoader = new ModelLoader();
+    modelThread = new QThread();
+    modelLoader->moveToThread(modelThread);
+    connect(this, &MainWindow::modelRequested, modelLoader, &ModelLoader::load);
+    connect(modelLoader, &ModelLoader::loaded, this, &MainWindow::onModelLoaded);
+    connect(modelLoader, &ModelLoader::loadFailed, this, &MainWindow::onModelLoadFailed);
+    connect(modelLoader, &ModelLoader::tuneRequested, this, &MainWindow::onTuneRequested);
+    connect(inferencePool, &InferencePool::drained, this, &MainWindow::startPendingTune);
+    modelThread->start();
+
+    QAction* openModelAction = new QAction("모델 열기", this);
+    connect(openModelAction, &QAction::triggered, this, &MainWindow::openModel);
+    ui->menu->insertAction(ui->actionImportFile, openModelAction);
     connect(qobject_cast<ImageLabel*>(ui->videoLabel), &ImageLabel::boxCreated, this, &MainWindow::onBoxCreated);
 
-    loadModel();
+    startSources();
 
-    workerThread->start();
-    inferenceThread->start();
+    QString startupModel = inference.modelPath;
+    if (startupModel.isEmpty())
+        startupModel = QSettings("YoloWebCam", "YoloWebCam").value("model/path").toString();
+    if (!startupModel.isEmpty())
+        loadModel(startupModel);
+    else
+        ui->statusbar->showMessage("No model loaded (파일 > 모델 열기)");
 }
 
 MainWindow::~MainWindow()
 {
+    cleanupWorker();
     delete ui;
 }
 
-void MainWindow::loadModel()
+void MainWindow::loadModel(const QString& path)
+{
+    // 🔥 백그라운드 로드 요청만 하고 바로 돌아온다 (워커 수만큼 Net 을 따로 준비)
+    ++modelGeneration;
+    ui->statusbar->showMessage("Loading model: " + path);
+    emit modelRequested(modelGeneration, path, modelConfig, inferencePool->workerCount());
+    modelConfig.retune = false;  // 다시 측정은 한 번만, 이후 교체는 저장된 결과 사용
+}
+
+void MainWindow::openModel()
+{
+    QString dir = modelPath.isEmpty() ? QString() : QFileInfo(modelPath).absolutePath();
+    QString path = QFileDialog::getOpenFileName(this, tr("모델 선택"), dir, "ONNX (*.onnx)");
+    if (!path.isEmpty())
+        loadModel(path);
+}
+
+void MainWindow::onTuneRequested(int generation, const QString& path, const ModelConfig& config)
+{
+    if (generation != modelGeneration)
+        return;
+
+    // 🔥 autotune 은 cv::setNumThreads (프로세스 전역) 를 바꿔 가며 재므로, 이전 모델의 워커가 forward 중이면
+    //    측정도 라이브 지연도 틀어진다. 새 배치를 멈추고 처리 중인 배치가 끝난 뒤 (drained) 측정을 시작
+    tuneGeneration = generation;
+    tunePath = path;
+    tuneConfig = config;
+    tuneConfig.tuneAllowed = true;
+    ui->statusbar->showMessage("Tuning model: " + path);
+    inferencePool->setPaused(true);
+    if (inferencePool->idleCount() == inferencePool->workerCount())
+        startPendingTune();
+}
+
+void MainWindow::startPendingTune()
 {
-    net = cv::dnn::readNetFromONNX("/home/park/ws/YoloWebCam/pt2onnx/best.onnx");
+    if (tuneGeneration == 0)
+        return;
 
-    if (net.empty()) {
-        qWarning("Failed to load ONNX model.");
+    const int generation = tuneGeneration;
+    tuneGeneration = 0;
+    if (generation != modelGeneration) {
+        inferencePool->setPaused(false);   // 기다리는 사이 다른 모델을 골랐다
         return;
     }
+    emit modelRequested(generation, tunePath, tuneConfig, inferencePool->workerCount());
+}
+
+void MainWindow::onModelLoaded(int generation, const QString& path, const NetList& nets, const ModelConfig& config, double ms)
+{
+    if (tuneGeneration == 0)
+        inferencePool->setPaused(false);   // autotune 이 끝났으면 다시 추론
+
+    // 그 사이에 다른 모델을 골랐으면 버린다
+    if (generation != modelGeneration)
+        return;
 
-    net.setPreferableBackend(cv::dnn::DNN_BACKEND_CUDA);  // CUDA 사용
-    net.setPreferableTarget(cv::dnn::DNN_TARGET_CUDA);    // GPU 사용
+    // 🔥 파이프라인은 그대로 두고 워커마다 다음 배치부터 새 모델 (이전 모델은 처리 중인 배치가 끝나면 해제)
+    inferencePool->setModels(nets, config.inputSize, config.dynamicShape);
+    modelLoaded = true;
+    modelPath = path;
+    QSettings("YoloWebCam", "YoloWebCam").setValue("model/path", path);
+    TuneResult applied;
+    applied.backend = config.backend;
+    applied.target = config.target;
+    applied.threads = config.threads;
+    applied.inputSize = config.inputSize;
+    modelDescription = Autotuner::describe(applied);
+    ui->statusbar->showMessage(QString("Model loaded: %1 [%2] (%3 ms)")
+                               .arg(QFileInfo(path).fileName(), modelDescription).arg(ms, 0, 'f', 0));
+}
+
+void MainWindow::onModelLoadFailed(int generation, const QString& path, const QString& error)
+{
+    if (tuneGeneration == 0)
+        inferencePool->setPaused(false);
+
+    if (generation != modelGeneration)
+        return;
 
-    inferenceWorker->setModel(net);
+    // 이전 모델이 있으면 그대로 계속 쓴다
+    qWarning("Failed to load ONNX model %s: %s", qPrintable(path), qPrintable(error));
+    ui->statusbar->showMessage("Failed to load model: " + path);
 }
 
-void MainWindow::onInferenceCompleted(const QImage& resultImage, double ms)
+void MainWindow::onInferenceCompleted(const FramePtr& frame, const std::vector<Detection>& detections, double ms)
 {
-    setImage(resultImage);
+    TRACE_SCOPE("gui.onInferenceCompleted", frame->sequence);
+
+    // 🔥 박스는 픽셀에 그려 넣지 않고 벡터로 넘긴다 (프레임 버퍼는 복사 없이 그대로 표시)
+    QVector<OverlayBox> boxes;
+    boxes.reserve(int(detections.size()));
+    for (const Detection& det : detections) {
+        OverlayBox box;
+        box.rect = QRectF(det.box.x, det.box.y, det.box.width, det.box.height);
+        QString label = classNames.contains(det.classId) ? classNames[det.classId] : QString::number(det.classId);
+        box.text = QString("%1 %2").arg(label).arg(det.confidence, 0, 'f', 2);
+        if (det.trackId > 0)
+            box.text.prepend(QString("#%1 ").arg(det.trackId));
+        boxes.push_back(box);
+    }
 
-    // 처리 시간 표시
-    ui->statusbar->showMessage(QString("Inference Time: %1 ms").arg(ms, 0, 'f', 2));
+    // 🔥 박스가 들어간 녹화는 녹화 스레드에서 그린다 (여기서는 버퍼 참조만 대기열에)
+    if (frame->sourceId == selectedSource && recorder->content() == RecordSettings::Annotated)
+        recorder->record(frame, detections);
+
+    QImage image = frameToQImage(frame);
+    if (videoGrid)
+        videoGrid->setFrame(frame->sourceId, image, boxes, QString("%1 det").arg(detections.size()));
+    if (frame->sourceId == selectedSource)
+        setImage(image, frame->sequence, false, boxes);
+
+    // 🔥 glass-to-glass: 캡처 시각 → 결과 표시 시각
+    qint64 now = frameClockUs();
+    lastFrameAgeMs = (now - frame->timestampUs) / 1000.0;
+    pipelineStats.inferenceRate.tick(now);
+    pipelineStats.endToEndMs.add(lastFrameAgeMs);
+    updateHud();
+
+    // 처리 시간 / 메일박스 카운터 표시
+    MailboxStats stats = inferencePool->stats();
+    ui->statusbar->showMessage(QString("Inference Time: %1 ms, Detections: %2, Processed: %3, Dropped: %4")
+                               .arg(ms, 0, 'f', 2)
+                               .arg(detections.size())
+                               .arg(stats.processed)
+                               .arg(stats.dropped));
 }
 
-void MainWindow::updateFrame(const QImage &frame)
+void MainWindow::updateFrame(const FramePtr &frame)
 {
-    currentFrame = frame;
-    setImage(currentFrame);  // 원본 표시용
+    TRACE_SCOPE("gui.updateFrame", frame->sequence);
+    pipelineStats.captureRate.tick(frameClockUs());
+
+    if (frame->sourceId == selectedSource) {
+        currentFrame = frameToQImage(frame);  // 복사 없이 공유 버퍼를 감쌈
+        lastFrame = frame;                    // 캡처 저장은 BGR 버퍼 그대로 인코더에
+
+        // 원본 녹화 (모델이 없으면 결과 프레임이 안 오므로 박스 녹화도 원본으로)
+        if (recorder->content() == RecordSettings::Raw || !modelLoaded)
+            recorder->record(frame);
+
+        // 🔥 추론 중이면 같은 캡처를 원본 / 결과로 두 번 그리지 않게 결과 프레임만 표시
+        if (!modelLoaded)
+            setImage(currentFrame, frame->sequence);
+    }
 
-    // QImage → cv::Mat 변환
-    cv::Mat mat(frame.height(), frame.width(), CV_8UC3, const_cast<uchar*>(frame.bits()), frame.bytesPerLine());
-    cv::Mat matRGB;
-    cv::cvtColor(mat, matRGB, cv::COLOR_RGB2BGR);
+    // 🔥 추론 풀의 소스별 대기열에 같은 버퍼 전달 (대기열이 차면 그 소스의 오래된 프레임은 버림)
+    inferencePool->submitFrame(frame);
 
-    // 🔥 inferenceWorker에 전달 (invokeMethod → 스레드 전송 안전하게)
-    QMetaObject::invokeMethod(inferenceWorker, "processFrame", Qt::QueuedConnection, Q_ARG(cv::Mat, matRGB));
+    // 🔥 버스트 캡처 중이면 간격에 맞는 프레임만 인코더로 (대기열이 차면 그 캡처만 버림)
+    if (frame->sourceId == selectedSource)
+        captureEncoder->offer(frame);
+}
+
+void MainWindow::startSources()
+{
+    // 멈춘 소스를 다시 켜면 파일 / 폴더도 처음부터 재생한다
+    finishedSources = 0;
+    for (const SourceSlot &slot : sources) {
+        if (!slot.thread->isRunning())
+            slot.thread->start();
+    }
+}
+
+void MainWindow::stopSources()
+{
+    // stop 은 캡처 루프 밖에서 플래그만 내림 → 루프가 끝나면 스레드 이벤트 루프 종료
+    for (const SourceSlot &slot : sources) {
+        slot.source->stop();
+        slot.thread->quit();
+    }
+    for (const SourceSlot &slot : sources)
+        slot.thread->wait();
+}
+
+bool MainWindow::sourcesRunning() const
+{
+    for (const SourceSlot &slot : sources) {
+        if (slot.thread->isRunning())
+            return true;
+    }
+    return false;
+}
+
+void MainWindow::setupVideoGrid()
+{
+    // 메인 화면 아래에 전체 소스 격자 (칸을 누르면 그 소스를 메인 화면으로)
+    int index = ui->mainLayout->indexOf(ui->videoLabel);
+    ui->mainLayout->removeWidget(ui->videoLabel);
+
+    QWidget* container = new QWidget(this);
+    QVBoxLayout* layout = new QVBoxLayout(container);
+    layout->setContentsMargins(0, 0, 0, 0);
+    videoGrid = new VideoGrid(container);
+    layout->addWidget(ui->videoLabel, 3);
+    layout->addWidget(videoGrid, 2);
+    ui->mainLayout->insertWidget(index, container, /*stretch=*/4);
+
+    QList<int> ids;
+    for (int id = 0; id < sources.size(); ++id)
+        ids << id;
+    videoGrid->setSourceIds(ids);
+    videoGrid->setSelected(selectedSource);
+    connect(videoGrid, &VideoGrid::sourceSelected, this, &MainWindow::selectSource);
+}
+
+void MainWindow::selectSource(int sourceId)
+{
+    selectedSource = sourceId;
+    if (videoGrid)
+        videoGrid->setSelected(sourceId);
+    ui->statusbar->showMessage(QString("Source #%1").arg(sourceId));
 }
 
 void MainWindow::cleanupWorker()
 {
-    // 웹캠 스레드 종료
-    if (webcamWorker) {
-        webcamWorker->stop();
+    // 표시 스레드 종료
+    displayTimer.stop();
+
+    // 녹화 / 버스트는 ui 가 살아 있을 때 끝낸다 (자식 소멸자에서 보내는 finished 시그널이 지워진 ui 를 건드리지 않게)
+    if (recorder)
+        recorder->stop();
+    if (captureEncoder)
+        captureEncoder->stopBurst();
+
+    if (displayThread) {
+        displayThread->quit();
+        displayThread->wait();
+        delete displayScaler;
+        delete displayThread;
+        displayScaler = nullptr;
+        displayThread = nullptr;
     }
 
-    if (workerThread) {
-        workerThread->quit();
-        workerThread->wait();
-        delete webcamWorker;
-        delete workerThread;
-        webcamWorker = nullptr;
-        workerThread = nullptr;
+    // 소스 스레드 종료
+    stopSources();
+    for (const SourceSlot &slot : sources) {
+        delete slot.source;
+        delete slot.thread;
+    }
+    sources.clear();
+
+    // 모델 로드 스레드 종료 (로드 중이면 끝날 때까지 기다림)
+    if (modelThread) {
+        modelThread->quit();
+        modelThread->wait();
+        delete modelLoader;
+        delete modelThread;
+        modelLoader = nullptr;
+        modelThread = nullptr;
     }
 
     // 추론 스레드 종료
-    if (inferenceThread) {
-        inferenceThread->quit();
-        inferenceThread->wait();
-        delete inferenceWorker;
-        delete inferenceThread;
-        inferenceWorker = nullptr;
-        inferenceThread = nullptr;
+    if (inferencePool) {
+        inferencePool->shutdown();
     }
 }
 
 
-void MainWindow::setImage(const QImage& image)
+void MainWindow::setImage(const QImage& image, quint64 frameId, bool smooth, const QVector<OverlayBox>& boxes)
 {
-    if (ui->videoLabel->size().isEmpty()) return;
-
-    QPixmap pixmap = QPixmap::fromImage(image);
+    // 여기서는 최신 이미지만 기억해 두고, 축소 / 표시는 onDisplayTick 에서 (중간 프레임은 덮어써서 버림)
+    displayImage = image;
+    displayBoxes = boxes;
+    displayFrameId = frameId;
+    displaySmooth = smooth;
+    displayDirty = true;
+}
 
+void MainWindow::onDisplayTick()
+{
     QSize labelSize = ui->videoLabel->size();
-    QPixmap scaledPixmap = pixmap.scaled(labelSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    if (scaleInFlight || displayImage.isNull() || labelSize.isEmpty())
+        return;
+
+    // 새 프레임이 왔거나 라벨 크기가 바뀌었을 때만 다시 축소
+    if (!displayDirty && labelSize == displayedSize)
+        return;
 
-    ui->videoLabel->setPixmap(scaledPixmap);
+    displayDirty = false;
+    displayedSize = labelSize;
+    scaleInFlight = true;
+    scaledBoxes = displayBoxes;       // 축소가 끝나 프레임이 바뀔 때 같이 적용
+    scaledImageSize = displayImage.size();
+    emit displayRequested(displayImage, labelSize, displaySmooth, displayFrameId);
+}
+
+void MainWindow::onDisplayScaled(const QImage& image, quint64 frameId)
+{
+    TRACE_SCOPE("gui.setPixmap", frameId);
+    scaleInFlight = false;
+
+    ImageLabel* label = qobject_cast<ImageLabel*>(ui->videoLabel);
+    label->setFrame(QPixmap::fromImage(image), scaledImageSize);
+    label->setBoxes(scaledBoxes);
+    pipelineStats.displayRate.tick(frameClockUs());
+}
+
+void MainWindow::onSourceFinished()
+{
+    if (!exitWhenFinished)
+        return;
+
+    // 카메라는 끝나지 않으므로 파일 / 폴더 소스만 센다
+    int replaySources = 0;
+    for (const SourceSlot &slot : sources)
+        replaySources += slot.source->isReplay() ? 1 : 0;
+    if (++finishedSources < replaySources)
+        return;
+
+    // 남은 추론 결과까지 받은 뒤 최종 지표 출력
+    QTimer* drain = new QTimer(this);
+    connect(drain, &QTimer::timeout, this, [this, drain]() {
+        if (inferencePool->pendingCount() > 0)
+            return;
+        drain->stop();
+        for (const QString& line : hudLines())
+            qInfo("%s", qPrintable(line));
+        qApp->quit();
+    });
+    drain->start(50);
+}
+
+void MainWindow::updateHud()
+{
+    ImageLabel* label = qobject_cast<ImageLabel*>(ui->videoLabel);
+    if (!label || !label->isOverlayVisible())
+        return;
+
+    label->setOverlayText(hudLines());
+}
+
+QStringList MainWindow::hudLines()
+{
+    qint64 now = frameClockUs();
+    MailboxStats stats = inferencePool->stats();
+    QStringList lines;
+    lines << QString("Model      %1").arg(modelLoaded ? QFileInfo(modelPath).fileName() + "  " + modelDescription : QString("(none)"));
+    lines << QString("Frame age  %1 ms").arg(lastFrameAgeMs, 0, 'f', 1);
+    lines << QString("Latency    p50 %1 / p95 %2 / p99 %3 ms")
+             .arg(pipelineStats.endToEndMs.percentile(0.50), 0, 'f', 1)
+             .arg(pipelineStats.endToEndMs.percentile(0.95), 0, 'f', 1)
+             .arg(pipelineStats.endToEndMs.percentile(0.99), 0, 'f', 1);
+    lines << QString("FPS        capture %1 / infer %2 / display %3")
+             .arg(pipelineStats.captureRate.rate(now), 0, 'f', 1)
+             .arg(pipelineStats.inferenceRate.rate(now), 0, 'f', 1)
+             .arg(pipelineStats.displayRate.rate(now), 0, 'f', 1);
+    lines << QString("Queue      %1 pending").arg(inferencePool->pendingCount());
+    lines << QString("Input      %1 px").arg(inferencePool->inputSize());
+    if (inferencePool->isTracking()) {
+        TrackerStats tracking = inferencePool->trackerStats();
+        lines << QString("Tracker    every %1 / tracks %2 / detected %3 / tracked %4")
+                 .arg(inferencePool->detectEvery())
+                 .arg(tracking.tracks)
+                 .arg(tracking.detected)
+                 .arg(tracking.tracked);
+    }
+    lines << QString("Dropped    %1 / %2").arg(stats.dropped).arg(stats.posted);
+    lines << QString("Capture    saved %1 / queued %2 / dropped %3%4")
+             .arg(captureEncoder->savedCount())
+             .arg(captureEncoder->pendingCount())
+             .arg(captureEncoder->droppedCount())
+             .arg(captureEncoder->isBursting() ? "  [burst]" : "");
+    if (recorder->isRecording()) {
+        lines << QString("Record     %1 frames / queued %2 / dropped %3")
+                 .arg(recorder->recordedCount())
+                 .arg(recorder->pendingCount())
+                 .arg(recorder->droppedCount());
+    }
+    if (sources.size() > 1) {
+        for (int id = 0; id < sources.size(); ++id) {
+            MailboxStats source = inferencePool->stats(id);
+            lines << QString("Source #%1  processed %2 / dropped %3").arg(id).arg(source.processed).arg(source.dropped);
+        }
+    }
+    return lines;
 }
 
 void MainWindow::setupImageLabel()
@@ -166,7 +582,7 @@ void MainWindow::setupImageLabel()
 
 void MainWindow::on_captureButton_clicked()
 {
-    if (currentFrame.isNull()) {
+    if (!lastFrame) {
         qWarning("No frame to capture.");
         return;
     }
@@ -176,17 +592,38 @@ void MainWindow::on_captureButton_clicked()
         return;
     }
 
-    QString subFolder = (currentTabIndex == 0) ? "train" : "val";
-
-    QString timestamp = QDateTime::currentDateTime().toString("yyyyMMddHHmmss");
-    QString savePath = currentDirectory + "/images/" + subFolder + "/capture_" + timestamp + ".jpg";
+    // 인코딩 / 저장은 백그라운드, 다 되면 onCaptureSaved 에서 리스트에 추가
+    if (!captureEncoder->capture(lastFrame, captureDirectory()))
+        ui->statusbar->showMessage("Capture queue is full, frame skipped.");
+}
 
-    if (currentFrame.save(savePath)) {
-        refreshFileList(); // 캡처 후 리스트 갱신
+void MainWindow::toggleBurstCapture()
+{
+    if (captureEncoder->isBursting()) {
+        captureEncoder->stopBurst();
+        return;
     }
-    else {
-        qWarning("Failed to save image.");
+
+    if (currentDirectory.isEmpty() || !sourcesRunning()) {
+        qWarning("Burst capture needs a running source and a dataset folder.");
+        return;
     }
+    captureEncoder->startBurst(captureDirectory());
+    ui->statusbar->showMessage("Burst capture started (F3 to stop)");
+}
+
+QString MainWindow::captureDirectory() const
+{
+    QString subFolder = (currentTabIndex == 0) ? "train" : "val";
+    return currentDirectory + "/images/" + subFolder;
+}
+
+void MainWindow::onCaptureSaved(const QString& path)
+{
+    // 저장하는 사이에 다른 폴더 / 탭으로 바뀌었으면 목록에 넣지 않음
+    QFileInfo info(path);
+    if (QDir::cleanPath(info.absolutePath()) == QDir::cleanPath(captureDirectory()))
+        datasetModel->addImage(info.fileName()); // 캡처한 파일만 리스트에 추가
 }
 
 
@@ -335,36 +772,21 @@ void MainWindow::refreshFileList()
         }
     }
 
-    // 🔥 이미지 파일만 필터링
-    QStringList filters;
-    filters << "*.png" << "*.jpg" << "*.jpeg" << "*.bmp";
-    imagesDir.setNameFilters(filters);
-    imagesDir.setFilter(QDir::Files | QDir::NoDotAndDotDot);
-
-    QFileInfoList entries = imagesDir.entryInfoList(QDir::Files | QDir::NoDotAndDotDot, QDir::Name);
-
-    ui->fileListWidget->clear();
-
-    for (const QFileInfo &entry : entries) {
-        QString baseName = entry.completeBaseName();  // 파일명 (확장자 제거)
-
-        QString labelFilePath = labelsPath + baseName + ".txt";
-        bool labelExists = QFile::exists(labelFilePath);
-
-        QListWidgetItem* item = new QListWidgetItem(entry.fileName());
-        if (labelExists) {
-            item->setForeground(Qt::blue);
-        } else {
-            item->setForeground(Qt::red);
-        }
-        ui->fileListWidget->addItem(item);
-    }
-
-    int fileCount = entries.count();
-    ui->imageInfoLabel->setText(QString("0 / %1").arg(fileCount));
+    // 🔥 목록은 백그라운드 스레드에서 읽고, 이후 변경은 QFileSystemWatcher 로 바뀐 행만 반영
+    datasetModel->setDirectories(imagesPath, labelsPath);
+    updateImageInfo();
     updatePathLabel(currentDirectory);
 }
 
+void MainWindow::updateImageInfo()
+{
+    int selectedIndex = ui->fileListView->currentIndex().isValid() ? ui->fileListView->currentIndex().row() + 1 : 0;
+    if (datasetModel->isScanning() && datasetModel->totalCount() == 0)
+        ui->imageInfoLabel->setText("...");
+    else
+        ui->imageInfoLabel->setText(QString("%1 / %2").arg(selectedIndex).arg(datasetModel->totalCount()));
+}
+
 void MainWindow::updatePathLabel(const QString& path)
 {
     QFontMetrics metrics(ui->pathLabel->font());
@@ -372,93 +794,136 @@ void MainWindow::updatePathLabel(const QString& path)
     ui->pathLabel->setText(elidedPath);
 }
 
-void MainWindow::on_fileItemClicked(QListWidgetItem* item)
+void MainWindow::on_fileItemClicked(const QModelIndex& index)
 {
-    if (!item)
+    if (!index.isValid())
         return;
 
-    // 1. 웹캠 스레드 정지
-    if (workerThread && workerThread->isRunning()) {
-        webcamWorker->stop();
-        workerThread->quit();
-        workerThread->wait();
+    // 1. 소스 스레드 정지
+    if (sourcesRunning()) {
+        captureEncoder->stopBurst();
+        stopSources();
     }
 
     // 2. 현재 탭에 따라 이미지/레이블 경로 결정
     QString subFolder = (currentTabIndex == 0) ? "train" : "val";
 
-    QString fileName = item->text();
+    QString fileName = datasetModel->fileName(index.row());
     QString imagePath = currentDirectory + "/images/" + subFolder + "/" + fileName;
     QString labelPath = currentDirectory + "/labels/" + subFolder + "/" + QFileInfo(fileName).completeBaseName() + ".txt";
 
-    // 3. 이미지 로드
-    QImage image;
-    if (!image.load(imagePath)) {
-        qWarning("Failed to load image: %s", qPrintable(imagePath));
-        return;
+    // 3. 캐시에 있으면 바로 표시, 없으면 백그라운드 디코딩이 끝날 때 (onCachedImageLoaded) 표시
+    //    이미 지나간 방향의 이웃 요청은 버리고 현재 이미지를 가장 먼저 읽는다
+    const QSize target = ui->videoLabel->size();
+    imageCache->cancelPending();
+    currentLabelPath = labelPath;
+
+    CachedImage cached;
+    if (imageCache->lookup(imagePath, target, cached)) {
+        pendingImagePath.clear();
+        showCachedImage(cached);
+    } else {
+        pendingImagePath = imagePath;
+        imageCache->request(imagePath, labelPath, target, kPrefetchDepth + 1);
     }
 
-    QPixmap pixmap = QPixmap::fromImage(image);
-    QPainter painter(&pixmap);
-    painter.setPen(QPen(Qt::red, 2)); // 빨간색, 굵기 2
-
-    // 4. 라벨 파일 읽기
-    QFile labelFile(labelPath);
-    if (labelFile.exists() && labelFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&labelFile);
-        while (!in.atEnd()) {
-            QString line = in.readLine();
-            QStringList parts = line.split(' ');
-            if (parts.size() != 5)
-                continue;
-
-            int class_id = parts[0].toInt();
-            float x_center = parts[1].toFloat();
-            float y_center = parts[2].toFloat();
-            float width = parts[3].toFloat();
-            float height = parts[4].toFloat();
-
-            int imgWidth = pixmap.width();
-            int imgHeight = pixmap.height();
-
-            QRectF box(
-                (x_center - width / 2) * imgWidth,
-                (y_center - height / 2) * imgHeight,
-                width * imgWidth,
-                height * imgHeight
-            );
-
-            painter.drawRect(box);
-
-            // 🔥 클래스 이름도 표시
-            if (classNames.contains(class_id)) {
-                painter.setPen(Qt::green); // 글자는 녹색
-                painter.drawText(box.topLeft() + QPointF(2, 12), classNames[class_id]);
-                painter.setPen(QPen(Qt::red, 2)); // 다시 박스는 빨간색
-            }
-        }
+    // 4. 🔥 탐색 방향으로 몇 장 미리 디코딩 (가까울수록 먼저), 반대쪽은 한 장만
+    for (int step = 1; step <= kPrefetchDepth; ++step)
+        prefetchRow(index.row() + browseDirection * step, target, kPrefetchDepth - step + 1);
+    prefetchRow(index.row() - browseDirection, target, 0);
+
+    // 5. 선택된 파일 인덱스 업데이트
+    updateImageInfo();
+    ui->captureButton->setDisabled(true);
+    ui->webcamButton->setDisabled(false);
+}
+
+void MainWindow::prefetchRow(int row, const QSize& target, int priority)
+{
+    if (row < 0 || row >= datasetModel->rowCount())
+        return;
 
-        labelFile.close();
+    QString subFolder = (currentTabIndex == 0) ? "train" : "val";
+    QString fileName = datasetModel->fileName(row);
+    imageCache->request(currentDirectory + "/images/" + subFolder + "/" + fileName,
+                        currentDirectory + "/labels/" + subFolder + "/" + QFileInfo(fileName).completeBaseName() + ".txt",
+                        target, priority);
+}
+
+QVector<OverlayBox> MainWindow::labelBoxes(const QVector<YoloLabel>& labels, const QSize& imageSize) const
+{
+    // 라벨은 정규화 좌표라 표시 중인 이미지 크기에 그대로 곱하면 된다 (이미지 자체는 건드리지 않음)
+    const double imgWidth = imageSize.width();
+    const double imgHeight = imageSize.height();
+
+    QVector<OverlayBox> boxes;
+    for (const YoloLabel &yolo : labels) {
+        OverlayBox box;
+        box.rect = QRectF(
+            (yolo.xCenter - yolo.width / 2) * imgWidth,
+            (yolo.yCenter - yolo.height / 2) * imgHeight,
+            yolo.width * imgWidth,
+            yolo.height * imgHeight
+        );
+
+        // 🔥 클래스 이름도 표시
+        box.text = classNames.value(yolo.classId);
+        boxes.push_back(box);
     }
+    return boxes;
+}
 
-    painter.end();
+void MainWindow::showCachedImage(const CachedImage& cached)
+{
+    // 🔥 아직 저장되지 않은 편집이 있을 수 있으므로 라벨은 메모리 사본이 우선
+    annotations->seed(currentLabelPath, cached.labels);
 
-    currentFrame = pixmap.toImage(); // currentFrame 업데이트
-    setImage(currentFrame);          // QLabel에 띄우기
+    currentFrame = cached.image;            // currentFrame 업데이트 (박스 없는 이미지 그대로)
+    setImage(currentFrame, 0, true, labelBoxes(annotations->labels(currentLabelPath), currentFrame.size()));
+}
 
-    // 5. 선택된 파일 인덱스 업데이트
-    int selectedIndex = ui->fileListWidget->row(item) + 1;
-    int totalCount = ui->fileListWidget->count();
+void MainWindow::onLabelsChanged(const QString& labelPath)
+{
+    // undo / redo 는 지금 보고 있지 않은 파일도 바꿀 수 있으므로 목록 표시는 바뀐 파일 기준으로 갱신
+    QVector<YoloLabel> labels = annotations->labels(labelPath);
+    datasetModel->setLabeledByLabelPath(labelPath, !labels.isEmpty());
 
-    ui->imageInfoLabel->setText(QString("%1 / %2").arg(selectedIndex).arg(totalCount));
-    ui->captureButton->setDisabled(true);
-    ui->webcamButton->setDisabled(false);
+    if (labelPath != currentLabelPath || !pendingImagePath.isEmpty() || sourcesRunning())
+        return;
+
+    // 프레임은 그대로 두고 바뀐 박스 영역만 다시 그림 (다시 축소해도 유지되게 displayBoxes 도 갱신)
+    QVector<OverlayBox> boxes = labelBoxes(labels, currentFrame.size());
+    displayBoxes = boxes;
+    scaledBoxes = boxes;
+    if (!scaleInFlight)
+        qobject_cast<ImageLabel*>(ui->videoLabel)->setBoxes(boxes);
+}
+
+void MainWindow::onCachedImageLoaded(const QString& imagePath)
+{
+    if (imagePath != pendingImagePath || sourcesRunning())
+        return;
+
+    CachedImage cached;
+    if (imageCache->lookup(imagePath, ui->videoLabel->size(), cached)) {
+        pendingImagePath.clear();
+        showCachedImage(cached);
+    }
+}
+
+void MainWindow::onCachedImageFailed(const QString& imagePath)
+{
+    if (imagePath != pendingImagePath)
+        return;
+
+    pendingImagePath.clear();
+    qWarning("Failed to load image: %s", qPrintable(imagePath));
 }
 
 void MainWindow::resumeWebcam()
 {
-    if (workerThread && !workerThread->isRunning()) {
-        workerThread->start();
+    if (!sourcesRunning()) {
+        startSources();
 
         ui->captureButton->setDisabled(false);
         ui->webcamButton->setDisabled(true);
@@ -474,35 +939,42 @@ void MainWindow::on_webcamButton_clicked()
 
 void MainWindow::on_prevButton_clicked()
 {
-    int currentRow = ui->fileListWidget->currentRow();
+    int currentRow = ui->fileListView->currentIndex().row();
+    browseDirection = -1;
     if (currentRow > 0) {
-        ui->fileListWidget->setCurrentRow(currentRow - 1);
-        on_fileItemClicked(ui->fileListWidget->currentItem()); // 항목 클릭 함수 호출
+        QModelIndex prev = datasetModel->index(currentRow - 1);
+        ui->fileListView->setCurrentIndex(prev);
+        on_fileItemClicked(prev); // 항목 클릭 함수 호출
     }
 }
 
 void MainWindow::on_nextButton_clicked()
 {
-    int currentRow = ui->fileListWidget->currentRow();
-    int totalCount = ui->fileListWidget->count();
+    int currentRow = ui->fileListView->currentIndex().row();
+    browseDirection = 1;
+
+    // 아직 뷰에 노출되지 않은 다음 행이면 먼저 가져온다
+    if (currentRow + 1 >= datasetModel->rowCount() && datasetModel->canFetchMore(QModelIndex()))
+        datasetModel->fetchMore(QModelIndex());
 
-    if (currentRow < totalCount - 1) {
-        ui->fileListWidget->setCurrentRow(currentRow + 1);
-        on_fileItemClicked(ui->fileListWidget->currentItem()); // 항목 클릭 함수 호출
+    if (currentRow < datasetModel->rowCount() - 1) {
+        QModelIndex next = datasetModel->index(currentRow + 1);
+        ui->fileListView->setCurrentIndex(next);
+        on_fileItemClicked(next); // 항목 클릭 함수 호출
     }
 }
 
 void MainWindow::on_fileDeleteButton_clicked()
 {
-    QListWidgetItem* item = ui->fileListWidget->currentItem();
-    if (!item) {
+    QModelIndex current = ui->fileListView->currentIndex();
+    if (!current.isValid()) {
         qWarning("No item selected for deletion.");
         return;
     }
 
     QString subFolder = (currentTabIndex == 0) ? "train" : "val";
 
-    QString fileName = item->text();
+    QString fileName = datasetModel->fileName(current.row());
     QString imagePath = currentDirectory + "/images/" + subFolder + "/" + fileName;
     QString labelPath = currentDirectory + "/labels/" + subFolder + "/" + QFileInfo(fileName).completeBaseName() + ".txt";
 
@@ -519,6 +991,9 @@ void MainWindow::on_fileDeleteButton_clicked()
         bool imageDeleted = false;
         bool labelDeleted = false;
 
+        // 저장 대기 중인 라벨이 지운 파일을 다시 만들지 않게
+        annotations->discard(labelPath);
+
         // 이미지 파일 삭제
         if (QFile::exists(imagePath)) {
             imageDeleted = QFile::remove(imagePath);
@@ -532,8 +1007,10 @@ void MainWindow::on_fileDeleteButton_clicked()
         if (imageDeleted || labelDeleted) {
             qDebug("Files deleted successfully.");
 
-            // 리스트 갱신
-            refreshFileList();
+            // 리스트에서 해당 행만 제거
+            imageCache->invalidate(imagePath);
+            datasetModel->removeImage(fileName);
+            updateImageInfo();
         } else {
             qWarning("Failed to delete files.");
             QMessageBox::warning(this, "삭제 실패", "파일 삭제에 실패했습니다.");
@@ -557,6 +1034,38 @@ void MainWindow::keyPressEvent(QKeyEvent *event)
         on_prevButton_clicked();
     } else if (event->key() == Qt::Key_Right || event->key() == Qt::Key_Down) {
         on_nextButton_clicked();
+    } else if (event->key() == Qt::Key_F2) {
+        // 🔥 지연 시간 HUD 토글
+        ImageLabel* label = qobject_cast<ImageLabel*>(ui->videoLabel);
+        if (label) {
+            label->setOverlayVisible(!label->isOverlayVisible());
+            updateHud();
+        }
+    } else if (event->key() == Qt::Key_F3) {
+        // 🔥 버스트 캡처 시작 / 정지
+        toggleBurstCapture();
+    } else if (event->key() == Qt::Key_F4) {
+        // 🔥 보이는 스트림 녹화 시작 / 정지
+        if (recorder->isRecording()) {
+            recorder->stop();
+        } else {
+            QString videoPath = recorder->start(classNames);
+            if (videoPath.isEmpty())
+                qWarning("Failed to start recording.");
+            else
+                ui->statusbar->showMessage("Recording: " + videoPath + " (F4 to stop)");
+        }
+    } else if (event->key() == Qt::Key_F12) {
+        // 🔥 지금까지의 추적 구간을 Chrome trace JSON 으로 저장 (CONFIG+=trace 빌드에서만, 아니면 빈 파일을 만들지 않음)
+#ifdef YOLO_TRACE
+        QString tracePath = QDir::current().filePath("trace_" + QDateTime::currentDateTime().toString("yyyyMMddHHmmss") + ".json");
+        if (Trace::dump(tracePath))
+            ui->statusbar->showMessage("Trace saved: " + tracePath);
+        else
+            qWarning("Failed to write trace file.");
+#else
+        ui->statusbar->showMessage("tracing not compiled in (build with CONFIG+=trace)");
+#endif
     } else {
         QMainWindow::keyPressEvent(event); // 기본 처리도 호출
     }
@@ -747,50 +1256,29 @@ void MainWindow::onBoxCreated(const QRectF& rect)
         return;
     }
 
-    if(ui->classListWidget->currentRow() == -1 || ui->fileListWidget->currentRow() == -1) return;
+    if(ui->classListWidget->currentRow() == -1 || !ui->fileListView->currentIndex().isValid()) return;
+    if (sourcesRunning() || !pendingImagePath.isEmpty()) return;  // 화면에 선택한 데이터셋 이미지가 아직 없음
 
     int selectedClassId = ui->classListWidget->currentRow();
-    QString currentImagePath = ui->fileListWidget->currentItem()->text();
 
-    // 현재 QLabel에 표시된 이미지 사이즈 (비율 유지됨)
-    QSize labelSize = ui->videoLabel->size();
+    ImageLabel* label = qobject_cast<ImageLabel*>(ui->videoLabel);
     QSize imageSize = currentFrame.size();
 
-    double scaleX = double(imageSize.width()) / labelSize.width();
-    double scaleY = double(imageSize.height()) / labelSize.height();
-
-    // 🔥 rect를 이미지 좌표계로 환산
-    double x = rect.x() * scaleX;
-    double y = rect.y() * scaleY;
-    double w = rect.width() * scaleX;
-    double h = rect.height() * scaleY;
-
-    double x_center = (x + w / 2.0) / imageSize.width();
-    double y_center = (y + h / 2.0) / imageSize.height();
-    double width = w / imageSize.width();
-    double height = h / imageSize.height();
-
-    // 🔥 정규화된 YOLO 포맷 완성
-    QString yoloFormat = QString("%1 %2 %3 %4 %5")
-                         .arg(selectedClassId) // 현재 선택된 클래스
-                         .arg(QString::number(x_center, 'f', 6))
-                         .arg(QString::number(y_center, 'f', 6))
-                         .arg(QString::number(width, 'f', 6))
-                         .arg(QString::number(height, 'f', 6));
+    // 🔥 rect를 이미지 좌표계로 환산 (비율 유지 + 가운데 정렬된 프레임 영역 기준)
+    QRectF imageRect = label->widgetToImage(rect) & QRectF(QPointF(0, 0), QSizeF(imageSize));
+    if (imageRect.isEmpty()) return;
 
-    qDebug() << "YOLO label:" << yoloFormat;
+    // 🔥 정규화된 YOLO 포맷 완성 (현재 선택된 클래스)
+    YoloLabel yolo;
+    yolo.classId = selectedClassId;
+    yolo.xCenter = (imageRect.x() + imageRect.width() / 2.0) / imageSize.width();
+    yolo.yCenter = (imageRect.y() + imageRect.height() / 2.0) / imageSize.height();
+    yolo.width = imageRect.width() / imageSize.width();
+    yolo.height = imageRect.height() / imageSize.height();
 
-    // 🔥 파일에 추가 저장
-    QString baseName = QFileInfo(currentImagePath).completeBaseName();
-    QString labelPath = currentDirectory + "/labels/" + baseName + ".txt";
+    qDebug() << "YOLO label:" << formatYoloLabel(yolo);
 
-    QFile file(labelPath);
-    if (file.open(QIODevice::Append | QIODevice::Text)) {
-        QTextStream out(&file);
-        out << yoloFormat << "\n";
-        file.close();
-    } else {
-        qWarning("Failed to open label file for writing.");
-    }
+    // 🔥 메모리 사본에 추가 → onLabelsChanged 에서 오버레이 갱신, 파일은 잠시 뒤 한 번에 저장
+    annotations->addLabel(currentLabelPath, yolo);
 }
 
@@ -8,10 +8,25 @@
 #include <opencv2/opencv.hpp>
 #include <QThread>
 #include <QListWidgetItem>
+#include <QModelIndex>
 #include <QMap>
 #include <QStringList>
+#include <QVector>
+#include "captureencoder.h"
+#include "imagelabel.h"
+#include "streamrecorder.h"
 #include "webcamworker.h"
-#include "inferenceworker.h"
+#include "inferencepool.h"
+#include "modelloader.h"
+#include "pipelinestats.h"
+#include "yololabel.h"
+
+class AnnotationStore;
+class DatasetModel;
+class DisplayScaler;
+class ImageCache;
+struct CachedImage;
+class VideoGrid;
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -22,17 +37,26 @@ class MainWindow : public QMainWindow
     Q_OBJECT
 
 public:
-    explicit MainWindow(QWidget *parent = nullptr);
+    explicit MainWindow(const CaptureSettings &capture = CaptureSettings(),
+                        const InferenceSettings &inference = InferenceSettings(),
+                        const QVector<SourceSettings> &sourceList = QVector<SourceSettings>(),
+                        const EncodeSettings &encode = EncodeSettings(),
+                        const RecordSettings &record = RecordSettings(),
+                        QWidget *parent = nullptr);
     ~MainWindow();
 
+    // 재생 소스가 모두 끝나고 추론이 비면 지표를 출력하고 종료 (CI / 헤드리스 실행)
+    void setExitWhenFinished(bool exit) { exitWhenFinished = exit; }
+
 private slots:
-    void updateFrame(const QImage &frame);
+    void updateFrame(const FramePtr &frame);
     void cleanupWorker();
     void on_setDirButton_clicked();
     void on_captureButton_clicked();
     void refreshFileList();
     void openFolder();
-    void on_fileItemClicked(QListWidgetItem* item);
+    void on_fileItemClicked(const QModelIndex& index);
+    void updateImageInfo();
     void resumeWebcam();
     void on_webcamButton_clicked();
     void on_prevButton_clicked();
@@ -43,8 +67,24 @@ private slots:
     void on_deleteClassButton_clicked();
     void setupImageLabel();
     void onBoxCreated(const QRectF& rect);
-    void loadModel();
-    void onInferenceCompleted(const QImage& resultImage, double ms);
+    void openModel();
+    void onModelLoaded(int generation, const QString& path, const NetList& nets, const ModelConfig& config, double ms);
+    void onModelLoadFailed(int generation, const QString& path, const QString& error);
+    void onTuneRequested(int generation, const QString& path, const ModelConfig& config);
+    void startPendingTune();
+    void onInferenceCompleted(const FramePtr& frame, const std::vector<Detection>& detections, double ms);
+    void selectSource(int sourceId);
+    void onSourceFinished();
+    void onDisplayTick();
+    void onDisplayScaled(const QImage& image, quint64 frameId);
+    void onCachedImageLoaded(const QString& imagePath);
+    void onCachedImageFailed(const QString& imagePath);
+    void onLabelsChanged(const QString& labelPath);
+    void onCaptureSaved(const QString& path);
+
+signals:
+    void displayRequested(const QImage& image, const QSize& target, bool smooth, quint64 frameId);
+    void modelRequested(int generation, const QString& path, const ModelConfig& config, int copies);
 
 protected:
     void keyPressEvent(QKeyEvent *event) override;
@@ -52,22 +92,83 @@ protected:
 private:
     Ui::MainWindow *ui;
     QImage currentFrame;            // 마지막 프레임 저장
+    FramePtr lastFrame;             // 선택된 소스의 마지막 캡처 버퍼 (캡처 저장용)
+    CaptureEncoder *captureEncoder; // 캡처 / 버스트 저장 (인코딩 스레드 풀)
+    StreamRecorder *recorder;       // 선택된 소스 스트림 녹화 (녹화 스레드)
 
     QString currentDirectory;  // 현재 폴더 경로 저장
+    DatasetModel *datasetModel;  // images/<split> 파일 목록 (백그라운드 인덱스)
     QMap<int, QString> classNames;
 
-    //
-    QThread *workerThread;
-    WebcamWorker *webcamWorker;
+    // 데이터셋 탐색: 디코딩된 이미지 LRU 캐시 + 탐색 방향 미리 읽기
+    static const int kPrefetchDepth = 4;
+    ImageCache *imageCache;
+    int browseDirection = 1;        // 마지막 이동 방향 (+1 다음, -1 이전)
+    QString pendingImagePath;       // 디코딩을 기다리는 현재 이미지 (다 되면 표시)
+    QString currentLabelPath;       // 선택한 이미지의 labels/<split>/<base>.txt
+    AnnotationStore *annotations;   // 라벨 메모리 사본 + undo / redo + 비동기 저장
+
+    // 입력 소스마다 자체 캡처 스레드
+    struct SourceSlot {
+        QThread *thread;
+        FrameSource *source;
+    };
+    QVector<SourceSlot> sources;
+    int selectedSource = 0;         // 메인 화면 / 캡처 / 라벨링 대상 소스
+    VideoGrid *videoGrid = nullptr; // 소스가 2개 이상일 때만
+    bool exitWhenFinished = false;
+    int finishedSources = 0;        // 이번 재생에서 끝난 파일 / 폴더 소스 수 (startSources 에서 초기화)
+    bool modelLoaded = false;
+
+    // 모델 로드 / 교체 (로드 스레드에서 준비 → 추론 워커에 넘김)
+    QThread *modelThread;
+    ModelLoader *modelLoader;
+    int modelGeneration = 0;        // 로드 요청마다 증가 (늦게 끝난 이전 요청은 버림)
+    QString modelPath;
+    ModelConfig modelConfig;        // 다음 로드에 쓸 설정 (backend 가 AutoBackend 면 autotune)
+    QString modelDescription;       // 실제 적용된 백엔드 / 타깃 / 스레드 / 입력 크기
+    int tuneGeneration = 0;         // 추론 풀이 비기를 기다리는 autotune 요청 (0 이면 없음)
+    QString tunePath;
+    ModelConfig tuneConfig;
+
+    // 표시 경로: 화면 주사율마다 최신 이미지 하나만 표시 스레드에서 축소해 온다
+    QThread *displayThread = nullptr;
+    DisplayScaler *displayScaler = nullptr;
+    QTimer displayTimer;
+    QImage displayImage;            // 마지막으로 표시 요청된 원본 크기 이미지
+    QVector<OverlayBox> displayBoxes;
+    QVector<OverlayBox> scaledBoxes;  // 축소 중인 프레임의 박스
+    QSize scaledImageSize;
+    quint64 displayFrameId = 0;
+    bool displaySmooth = false;
+    bool displayDirty = false;      // displayImage 가 아직 축소 요청되지 않음
+    bool scaleInFlight = false;     // 축소 결과를 기다리는 중 (그동안 새 요청 안 함)
+    QSize displayedSize;
+
+    // 추론 워커 풀 (워커마다 자체 스레드)
+    InferencePool *inferencePool;
 
-    // MainWindow.h
-    QThread *inferenceThread;
-    InferenceWorker *inferenceWorker;
+    // HUD 용 지연 시간 / FPS 지표
+    PipelineStats pipelineStats;
+    double lastFrameAgeMs = 0;
 
 
-    void setImage(const QImage& image);
+    void startSources();
+    void stopSources();
+    bool sourcesRunning() const;
+    void setupVideoGrid();
+    void setImage(const QImage& image, quint64 frameId = 0, bool smooth = false,
+                  const QVector<OverlayBox>& boxes = QVector<OverlayBox>());
     QImage cvMatToQImage(const cv::Mat &mat);
     void updatePathLabel(const QString& path);
+    void loadModel(const QString& path);
+    void toggleBurstCapture();
+    QString captureDirectory() const;
+    void prefetchRow(int row, const QSize& target, int priority);
+    void showCachedImage(const CachedImage& cached);
+    QVector<OverlayBox> labelBoxes(const QVector<YoloLabel>& labels, const QSize& imageSize) const;
+    QStringList hudLines();
+    void updateHud();
     void loadClassNames(const QString& yamlPath);
 };
 
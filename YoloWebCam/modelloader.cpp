@@ -0,0 +1,95 @@
+// modelloader.cpp
+#include "modelloader.h"
+#include "autotuner.h"
+#include "tracing.h"
+
+#include <QElapsedTimer>
+#include <algorithm>
+
+cv::dnn::Net ModelLoader::readModel(const QString &path, int backend, int target, int inputSize, QString *error,
+                                    bool *dynamicShape)
+{
+    try {
+        cv::dnn::Net net = cv::dnn::readNetFromONNX(path.toStdString());
+        if (net.empty()) {
+            if (error) *error = "empty network";
+            return net;
+        }
+        net.setPreferableBackend(backend);
+        net.setPreferableTarget(target);
+
+        // 🔥 워밍업: 1 x 3 x S x S 한 번 (백엔드 초기화가 여기서 끝난다)
+        const int sizes[] = { 1, 3, inputSize, inputSize };
+        net.setInput(cv::Mat(4, sizes, CV_32F, cv::Scalar(0)));
+        std::vector<cv::Mat> outputs;
+        net.forward(outputs, net.getUnconnectedOutLayersNames());
+
+        // 🔥 고정 shape 로 export 된 모델은 배치가 1 이 아니면 forward 에서 예외 → 추론 스레드에서 터지기 전에 여기서 확인
+        if (dynamicShape) {
+            try {
+                const int batchSizes[] = { 2, 3, inputSize, inputSize };
+                net.setInput(cv::Mat(4, batchSizes, CV_32F, cv::Scalar(0)));
+                net.forward(outputs, net.getUnconnectedOutLayersNames());
+                *dynamicShape = !outputs.empty() && outputs[0].dims == 3 && outputs[0].size[0] == 2;
+            } catch (const cv::Exception &) {
+                *dynamicShape = false;
+            }
+            if (!*dynamicShape) {
+                // 실패한 shape 대신 1장 shape 로 다시 준비해 둔다
+                net.setInput(cv::Mat(4, sizes, CV_32F, cv::Scalar(0)));
+                net.forward(outputs, net.getUnconnectedOutLayersNames());
+            }
+        }
+        return net;
+    } catch (const cv::Exception &e) {
+        if (error) *error = QString::fromStdString(e.what());
+        return cv::dnn::Net();
+    }
+}
+
+void ModelLoader::load(int generation, const QString &path, const ModelConfig &requested, int copies)
+{
+    TRACE_THREAD_NAME("model-loader");
+    TRACE_SCOPE("model.load", quint64(generation));
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // 🔥 autotune: 같은 모델 / CPU / OpenCV / 워커 수로 측정한 적이 있으면 그 결과를 바로 쓴다
+    ModelConfig config = requested;
+    if (config.backend == ModelConfig::AutoBackend) {
+        const QString key = Autotuner::cacheKey(path, copies);
+        TuneResult best;
+        if (config.retune || !Autotuner::cached(key, best)) {
+            if (!config.tuneAllowed) {
+                emit tuneRequested(generation, path, config);
+                return;
+            }
+            best = Autotuner::tune(path, copies, config.tuneInputSizes);
+            if (!best.isValid()) {
+                emit loadFailed(generation, path, "no backend could run the model");
+                return;
+            }
+            Autotuner::store(key, best);
+        }
+        config.backend = best.backend;
+        config.target = best.target;
+        config.threads = best.threads;
+        config.inputSize = best.inputSize;
+    }
+    if (config.threads > 0)
+        cv::setNumThreads(config.threads);
+
+    NetList nets;
+    for (int i = 0; i < std::max(1, copies); ++i) {
+        QString error;
+        cv::dnn::Net net = readModel(path, config.backend, config.target, config.inputSize, &error,
+                                     i == 0 ? &config.dynamicShape : nullptr);
+        if (net.empty()) {
+            emit loadFailed(generation, path, error);
+            return;
+        }
+        nets.push_back(net);
+    }
+    emit loaded(generation, path, nets, config, double(timer.elapsed()));
+}
@@ -0,0 +1,52 @@
+// modelloader.h
+#pragma once
+#include <QMetaType>
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <vector>
+#include <opencv2/dnn.hpp>
+
+typedef std::vector<cv::dnn::Net> NetList;
+
+Q_DECLARE_METATYPE(NetList)
+
+// 모델 실행 설정. backend 가 AutoBackend 면 로더가 Autotuner 결과 (저장된 값 또는 새로 측정) 로 채운다
+struct ModelConfig {
+    enum { AutoBackend = -1 };
+
+    int backend = cv::dnn::DNN_BACKEND_CUDA;
+    int target = cv::dnn::DNN_TARGET_CUDA;
+    int threads = 0;                        // cv::setNumThreads (0 이면 그대로, 프로세스 전역)
+    int inputSize = 640;
+    QVector<int> tuneInputSizes = { 640 };  // autotune 이 비교할 입력 크기 (작을수록 빠르지만 정확도가 떨어짐)
+    bool retune = false;                    // 저장된 autotune 결과를 무시하고 다시 측정
+    bool tuneAllowed = false;               // 추론 풀을 멈춘 뒤에만 true (측정이 프로세스 전역 스레드 수를 바꾼다)
+    bool dynamicShape = true;               // 로더가 채운다: 배치 2 시험 forward 가 되면 true (아니면 배치 / 타일 배치 / 입력 크기 조절을 1장 고정으로)
+};
+
+Q_DECLARE_METATYPE(ModelConfig)
+
+// ONNX 읽기 + 백엔드 설정 + 워밍업 forward 를 전용 스레드에서 한다.
+// 첫 forward 에서 일어나는 레이어 초기화 / CUDA 커널 준비가 라이브 프레임에 걸리지 않게 미리 한 번 돌린다
+class ModelLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    // 동기 버전 (벤치마크 / 로더 스레드 공용). 실패하면 빈 Net 과 error.
+    // dynamicShape 를 주면 배치 2 로 한 번 더 forward 해서 dynamic=True 로 export 된 모델인지 알려 준다
+    static cv::dnn::Net readModel(const QString &path, int backend, int target, int inputSize = 640, QString *error = nullptr,
+                                  bool *dynamicShape = nullptr);
+
+public slots:
+    // 워커 수 (copies) 만큼 Net 을 따로 만든다 (Net 은 스레드 간에 공유하지 않음)
+    void load(int generation, const QString &path, const ModelConfig &config, int copies);
+
+signals:
+    // config 는 실제로 적용한 설정 (autotune 이면 고른 결과)
+    void loaded(int generation, const QString &path, const NetList &nets, const ModelConfig &config, double ms);
+    // 측정이 필요한데 tuneAllowed 가 아니면 로드하지 않고 요청만 돌려보낸다 (풀을 비운 뒤 tuneAllowed 로 다시 요청)
+    void tuneRequested(int generation, const QString &path, const ModelConfig &config);
+    void loadFailed(int generation, const QString &path, const QString &error);
+};
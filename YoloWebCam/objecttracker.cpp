@@ -0,0 +1,191 @@
+// objecttracker.cpp
+#include "objecttracker.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+float iou(const cv::Rect2f &a, const cv::Rect2f &b)
+{
+    const float inter = (a & b).area();
+    return inter > 0 ? inter / (a.area() + b.area() - inter) : 0.f;
+}
+
+// 박스 → 측정값 (cx, cy, 면적, 종횡비)
+cv::Mat_<float> measurement(const cv::Rect2f &box)
+{
+    cv::Mat_<float> z(4, 1);
+    z(0) = box.x + box.width / 2;
+    z(1) = box.y + box.height / 2;
+    z(2) = box.width * box.height;
+    z(3) = box.width / std::max(box.height, 1e-3f);
+    return z;
+}
+
+} // namespace
+
+ObjectTracker::ObjectTracker(const TrackSettings &settings)
+    : config(settings), nextId(1)
+{
+}
+
+void ObjectTracker::reset()
+{
+    tracks.clear();
+    nextId = 1;
+}
+
+bool ObjectTracker::needsDetection() const
+{
+    for (const Track &track : tracks) {
+        if (track.missed == 0 && (track.hits < 2 || track.confidence < config.redetectConfidence))
+            return true;
+    }
+    return false;
+}
+
+ObjectTracker::Track ObjectTracker::createTrack(const Detection &det)
+{
+    Track track;
+    track.id = nextId++;
+    track.classId = det.classId;
+    track.confidence = det.confidence;
+    track.hits = 1;
+    track.missed = 0;
+
+    // 상태 (cx, cy, s, r, vx, vy, vs) 등속 모델, 종횡비는 고정 (SORT 와 같은 잡음 설정)
+    cv::KalmanFilter &kf = track.filter;
+    kf.init(7, 4, 0, CV_32F);
+    cv::setIdentity(kf.transitionMatrix);
+    kf.transitionMatrix.at<float>(0, 4) = 1.f;
+    kf.transitionMatrix.at<float>(1, 5) = 1.f;
+    kf.transitionMatrix.at<float>(2, 6) = 1.f;
+    cv::setIdentity(kf.measurementMatrix);
+    kf.measurementNoiseCov = cv::Mat::diag((cv::Mat_<float>(4, 1) << 1, 1, 10, 10));
+    kf.processNoiseCov = cv::Mat::diag((cv::Mat_<float>(7, 1) << 1, 1, 1, 1, 0.01f, 0.01f, 1e-4f));
+    kf.errorCovPost = cv::Mat::diag((cv::Mat_<float>(7, 1) << 10, 10, 10, 10, 1e4f, 1e4f, 1e4f));
+    kf.statePost = cv::Mat::zeros(7, 1, CV_32F);
+    measurement(det.box).copyTo(kf.statePost.rowRange(0, 4));
+    return track;
+}
+
+void ObjectTracker::advance(Track &track)
+{
+    // 면적이 음수로 예측되지 않게 면적 속도를 멈춘다
+    cv::Mat &state = track.filter.statePost;
+    if (state.at<float>(2) + state.at<float>(6) <= 0)
+        state.at<float>(6) = 0;
+    track.filter.predict();   // statePre 를 statePost 에도 복사한다
+}
+
+cv::Rect2f ObjectTracker::stateBox(const Track &track) const
+{
+    const cv::Mat &state = track.filter.statePost;
+    const float area = std::max(state.at<float>(2), 1.f);
+    const float ratio = std::max(state.at<float>(3), 1e-3f);
+    const float width = std::sqrt(area * ratio);
+    const float height = area / width;
+    return cv::Rect2f(state.at<float>(0) - width / 2, state.at<float>(1) - height / 2, width, height);
+}
+
+void ObjectTracker::match(const std::vector<Detection> &detections, const std::vector<int> &candidates,
+                          std::vector<bool> &trackMatched, std::vector<int> &unmatched)
+{
+    // 🔥 같은 클래스 (트랙, 검출) 쌍을 IoU 큰 순서로 탐욕 매칭
+    struct Pair {
+        float iou;
+        int track;
+        int detection;
+    };
+    std::vector<Pair> pairs;
+    for (size_t t = 0; t < tracks.size(); ++t) {
+        if (trackMatched[t])
+            continue;
+        const cv::Rect2f box = stateBox(tracks[t]);
+        for (int d : candidates) {
+            if (detections[d].classId != tracks[t].classId)
+                continue;
+            const float overlap = iou(box, detections[d].box);
+            if (overlap >= config.matchIou)
+                pairs.push_back({ overlap, int(t), d });
+        }
+    }
+    std::sort(pairs.begin(), pairs.end(), [](const Pair &a, const Pair &b) { return a.iou > b.iou; });
+
+    std::vector<bool> detectionMatched(detections.size(), false);
+    for (const Pair &pair : pairs) {
+        if (trackMatched[pair.track] || detectionMatched[pair.detection])
+            continue;
+        trackMatched[pair.track] = true;
+        detectionMatched[pair.detection] = true;
+
+        Track &track = tracks[pair.track];
+        const Detection &det = detections[pair.detection];
+        track.filter.correct(measurement(det.box));
+        track.confidence = det.confidence;
+        track.hits++;
+        track.missed = 0;
+    }
+
+    for (int d : candidates) {
+        if (!detectionMatched[d])
+            unmatched.push_back(d);
+    }
+}
+
+void ObjectTracker::update(const std::vector<Detection> &detections, std::vector<Detection> &results)
+{
+    for (Track &track : tracks)
+        advance(track);
+
+    // ByteTrack: 높은 점수 검출로 먼저 매칭하고, 낮은 점수 검출은 남은 트랙을 이어 붙이는 데만 쓴다
+    std::vector<int> high;
+    std::vector<int> low;
+    for (size_t i = 0; i < detections.size(); ++i)
+        (detections[i].confidence >= config.highScore ? high : low).push_back(int(i));
+
+    std::vector<bool> trackMatched(tracks.size(), false);
+    std::vector<int> unmatchedHigh;
+    std::vector<int> unmatchedLow;
+    match(detections, high, trackMatched, unmatchedHigh);
+    match(detections, low, trackMatched, unmatchedLow);
+
+    // 못 찾은 트랙은 숨기고 maxMissed 번까지는 다시 매칭될 기회를 준다
+    for (size_t t = 0; t < tracks.size(); ++t) {
+        if (!trackMatched[t])
+            tracks[t].missed++;
+    }
+    tracks.erase(std::remove_if(tracks.begin(), tracks.end(),
+                                [this](const Track &track) { return track.missed > config.maxMissed; }),
+                 tracks.end());
+
+    for (int d : unmatchedHigh)
+        tracks.push_back(createTrack(detections[d]));
+
+    output(results);
+}
+
+void ObjectTracker::predict(std::vector<Detection> &results)
+{
+    for (Track &track : tracks) {
+        advance(track);
+        if (track.missed == 0)
+            track.confidence *= config.confidenceDecay;
+    }
+    output(results);
+}
+
+void ObjectTracker::output(std::vector<Detection> &results) const
+{
+    results.clear();
+    for (const Track &track : tracks) {
+        if (track.missed > 0)
+            continue;
+        Detection det;
+        det.box = stateBox(track);
+        det.classId = track.classId;
+        det.confidence = track.confidence;
+        det.trackId = track.id;
+        results.push_back(det);
+    }
+}
@@ -0,0 +1,69 @@
+// objecttracker.h
+#pragma once
+#include <QtGlobal>
+#include <vector>
+#include <opencv2/core.hpp>
+#include <opencv2/video/tracking.hpp>
+#include "yolodecoder.h"
+
+// 검출기 사이 프레임 추적 설정
+struct TrackSettings {
+    bool enabled = false;
+    int detectEvery = 1;              // K: 검출기는 K 프레임마다 한 번, 나머지는 트랙 예측으로 (1 이면 매 프레임 검출 + ID 만)
+    float highScore = 0.5f;           // 이 점수 이상 검출만 먼저 매칭하고 새 트랙을 만든다 (낮은 검출은 남은 트랙에만)
+    float matchIou = 0.3f;            // 예측 박스와 검출 박스 매칭 최소 IoU
+    int maxMissed = 2;                // 연속으로 이만큼 넘게 검출에서 못 찾으면 트랙 삭제
+    float confidenceDecay = 0.9f;     // 예측만 한 프레임마다 트랙 신뢰도에 곱하는 값
+    float redetectConfidence = 0.3f;  // 보이는 트랙 신뢰도가 이 아래로 떨어지면 K 를 기다리지 않고 다음 프레임 검출
+};
+
+// 소스별 추적 카운터
+struct TrackerStats {
+    quint64 detected = 0;   // 검출기 결과로 갱신한 프레임 수
+    quint64 tracked = 0;    // 예측만으로 내보낸 프레임 수
+    int tracks = 0;         // 지금 보이는 트랙 수
+};
+
+// SORT 방식 다중 물체 추적기: 트랙마다 등속 칼만 필터 (cx, cy, 면적, 종횡비 + 속도),
+// 검출이 오면 ByteTrack 처럼 높은 점수 → 낮은 점수 순서로 같은 클래스끼리 IoU 탐욕 매칭.
+// 프레임은 반드시 sequence 순서로 넣어야 한다 (InferencePool 이 소스마다 하나씩 GUI 스레드에서 사용)
+class ObjectTracker
+{
+public:
+    explicit ObjectTracker(const TrackSettings &settings = TrackSettings());
+
+    void setSettings(const TrackSettings &settings) { config = settings; }
+    const TrackSettings &settings() const { return config; }
+
+    // 검출기를 돌린 프레임: 예측 → 매칭 → 보정. results 는 이번 프레임에 찾은 트랙 (trackId 포함)
+    void update(const std::vector<Detection> &detections, std::vector<Detection> &results);
+
+    // 검출기를 건너뛴 프레임: 예측 박스만
+    void predict(std::vector<Detection> &results);
+
+    // 보이는 트랙 중 새 트랙 (속도 모름) 이나 신뢰도가 떨어진 트랙이 있어 K 를 기다리지 않고 검출해야 하는지
+    bool needsDetection() const;
+
+    void reset();
+
+private:
+    struct Track {
+        int id;
+        int classId;
+        float confidence;   // 마지막 검출 점수 x decay^(예측만 한 프레임 수)
+        int hits;           // 매칭된 검출 수 (1 이면 아직 속도를 모름)
+        int missed;         // 연속으로 검출에서 못 찾은 횟수 (0 이면 보이는 트랙)
+        cv::KalmanFilter filter;
+    };
+
+    Track createTrack(const Detection &det);
+    void advance(Track &track);
+    cv::Rect2f stateBox(const Track &track) const;
+    void match(const std::vector<Detection> &detections, const std::vector<int> &candidates,
+               std::vector<bool> &trackMatched, std::vector<int> &unmatched);
+    void output(std::vector<Detection> &results) const;
+
+    TrackSettings config;
+    std::vector<Track> tracks;
+    int nextId;
+};
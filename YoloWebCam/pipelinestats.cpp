@@ -0,0 +1,53 @@
+// pipelinestats.cpp
+#include "pipelinestats.h"
+#include <algorithm>
+
+void RateMeter::expire(qint64 nowUs)
+{
+    while (!ticks.empty() && nowUs - ticks.front() > windowUs)
+        ticks.pop_front();
+}
+
+void RateMeter::tick(qint64 nowUs)
+{
+    ticks.push_back(nowUs);
+    expire(nowUs);
+}
+
+double RateMeter::rate(qint64 nowUs)
+{
+    expire(nowUs);
+    if (ticks.size() < 2)
+        return 0;
+
+    const qint64 span = ticks.back() - ticks.front();
+    return span > 0 ? (ticks.size() - 1) * 1e6 / span : 0;
+}
+
+LatencyWindow::LatencyWindow(int capacity)
+    : next(0), capacity(size_t(std::max(1, capacity)))
+{
+    samples.reserve(this->capacity);
+    scratch.reserve(this->capacity);
+}
+
+void LatencyWindow::add(double ms)
+{
+    if (samples.size() < capacity) {
+        samples.push_back(ms);
+    } else {
+        samples[next] = ms;
+        next = (next + 1) % capacity;
+    }
+}
+
+double LatencyWindow::percentile(double p) const
+{
+    if (samples.empty())
+        return 0;
+
+    scratch.assign(samples.begin(), samples.end());
+    const size_t index = std::min(scratch.size() - 1, size_t(p * (scratch.size() - 1) + 0.5));
+    std::nth_element(scratch.begin(), scratch.begin() + index, scratch.end());
+    return scratch[index];
+}
@@ -0,0 +1,47 @@
+// pipelinestats.h
+#pragma once
+#include <QtGlobal>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+// 최근 windowUs 동안의 이벤트 수로 FPS 계산
+class RateMeter
+{
+public:
+    explicit RateMeter(qint64 windowUs = 2000000) : windowUs(windowUs) {}
+
+    void tick(qint64 nowUs);
+    double rate(qint64 nowUs);
+
+private:
+    void expire(qint64 nowUs);
+
+    qint64 windowUs;
+    std::deque<qint64> ticks;
+};
+
+// 최근 capacity 개 지연 시간 (ms) 의 백분위수
+class LatencyWindow
+{
+public:
+    explicit LatencyWindow(int capacity = 300);
+
+    void add(double ms);
+    double percentile(double p) const;
+    int count() const { return int(samples.size()); }
+
+private:
+    std::vector<double> samples;
+    size_t next;
+    size_t capacity;
+    mutable std::vector<double> scratch;
+};
+
+// 캡처 → 표시까지 (glass-to-glass) 파이프라인 지표
+struct PipelineStats {
+    RateMeter captureRate;
+    RateMeter inferenceRate;
+    RateMeter displayRate;
+    LatencyWindow endToEndMs;      // 캡처 시각 → 결과 표시 시각
+};
@@ -0,0 +1,116 @@
+// preprocessor.cpp
+#include "preprocessor.h"
+#include <algorithm>
+#include <cmath>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/core/hal/intrin.hpp>
+
+static const uchar kPadValue = 114;  // ultralytics 레터박스 기본 패딩 색
+
+#if CV_SIMD
+// u8 lanes 개 → float 4 x (lanes/4) 개로 확장, 1/255 스케일 후 저장
+static inline void storeScaled(const cv::v_uint8 &v, float *dst, const cv::v_float32 &scale)
+{
+    const int n = cv::v_float32::nlanes;
+    cv::v_uint16 lo, hi;
+    cv::v_expand(v, lo, hi);
+    cv::v_uint32 a, b, c, d;
+    cv::v_expand(lo, a, b);
+    cv::v_expand(hi, c, d);
+    cv::v_store(dst, cv::v_cvt_f32(cv::v_reinterpret_as_s32(a)) * scale);
+    cv::v_store(dst + n, cv::v_cvt_f32(cv::v_reinterpret_as_s32(b)) * scale);
+    cv::v_store(dst + 2 * n, cv::v_cvt_f32(cv::v_reinterpret_as_s32(c)) * scale);
+    cv::v_store(dst + 3 * n, cv::v_cvt_f32(cv::v_reinterpret_as_s32(d)) * scale);
+}
+#endif
+
+// 🔥 BGR interleaved 한 행 → R, G, B planar float (정규화 + 채널 스왑 + 분리를 한 번에)
+static void packRow(const uchar *src, int width, float *r, float *g, float *b)
+{
+    const float scale = 1.f / 255.f;
+    int x = 0;
+
+#if CV_SIMD
+    const int lanes = cv::v_uint8::nlanes;
+    const cv::v_float32 vScale = cv::vx_setall_f32(scale);
+    for (; x <= width - lanes; x += lanes) {
+        cv::v_uint8 vb, vg, vr;
+        cv::v_load_deinterleave(src + 3 * x, vb, vg, vr);
+        storeScaled(vr, r + x, vScale);
+        storeScaled(vg, g + x, vScale);
+        storeScaled(vb, b + x, vScale);
+    }
+    cv::vx_cleanup();
+#endif
+
+    for (; x < width; ++x) {
+        b[x] = src[3 * x] * scale;
+        g[x] = src[3 * x + 1] * scale;
+        r[x] = src[3 * x + 2] * scale;
+    }
+}
+
+Preprocessor::Preprocessor(int inputSize)
+{
+    setInputSize(inputSize);
+}
+
+void Preprocessor::setInputSize(int inputSize)
+{
+    size = inputSize;
+    const int sizes[] = { 1, 3, size, size };
+    blob.create(4, sizes, CV_32F);
+    canvas.create(size, size, CV_8UC3);
+    source = cv::Size();  // 다음 프레임에서 지오메트리 다시 계산
+}
+
+void Preprocessor::updateGeometry(const cv::Size &frameSize)
+{
+    if (frameSize == source)
+        return;
+
+    source = frameSize;
+    const float scale = std::min(float(size) / source.width, float(size) / source.height);
+    const int w = std::min(size, int(std::round(source.width * scale)));
+    const int h = std::min(size, int(std::round(source.height * scale)));
+
+    roi = cv::Rect((size - w) / 2, (size - h) / 2, w, h);
+    info.scale = scale;
+    info.padX = roi.x;
+    info.padY = roi.y;
+
+    // 패딩 영역은 매 프레임 같으므로 여기서 한 번만 채운다
+    canvas.setTo(cv::Scalar::all(kPadValue));
+}
+
+const cv::Mat &Preprocessor::process(const cv::Mat &frame, LetterboxInfo &letterbox)
+{
+    letterbox = process(frame, blob.ptr<float>());
+    return blob;
+}
+
+LetterboxInfo Preprocessor::process(const cv::Mat &frame, float *dst)
+{
+    CV_Assert(frame.type() == CV_8UC3);
+
+    updateGeometry(frame.size());
+
+    // 이미 입력 크기와 같으면 리사이즈 없이 바로 변환
+    const cv::Mat *packed = &frame;
+    if (frame.size() != canvas.size()) {
+        cv::Mat target = canvas(roi);
+        cv::resize(frame, target, roi.size(), 0, 0, cv::INTER_LINEAR);
+        packed = &canvas;
+    }
+
+    const size_t plane = size_t(size) * size;
+    float *r = dst;
+    float *g = dst + plane;
+    float *b = dst + 2 * plane;
+    for (int y = 0; y < size; ++y) {
+        const size_t offset = size_t(y) * size;
+        packRow(packed->ptr<uchar>(y), size, r + offset, g + offset, b + offset);
+    }
+
+    return info;
+}
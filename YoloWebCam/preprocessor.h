@@ -0,0 +1,42 @@
+// preprocessor.h
+#pragma once
+#include <opencv2/core.hpp>
+
+// 레터박스 변환 정보 (네트워크 입력 좌표 ↔ 원본 프레임 좌표)
+struct LetterboxInfo {
+    float scale = 1.f;
+    int padX = 0;
+    int padY = 0;
+
+    cv::Rect2f toSource(const cv::Rect2f &box) const
+    {
+        return cv::Rect2f((box.x - padX) / scale, (box.y - padY) / scale, box.width / scale, box.height / scale);
+    }
+};
+
+// 비율 유지 레터박스 전처리.
+// BGR 8UC3 프레임 → 미리 할당된 NCHW float 버퍼 (resize + pad + 1/255 + BGR→RGB + planar 분리)
+class Preprocessor
+{
+public:
+    explicit Preprocessor(int inputSize = 640);
+
+    void setInputSize(int size);
+    int inputSize() const { return size; }
+
+    // 내부 blob (1, 3, size, size) 에 채워서 반환. 같은 크기의 프레임이 계속 들어오면 재할당 없음
+    const cv::Mat &process(const cv::Mat &frame, LetterboxInfo &info);
+
+    // 외부 버퍼 (3 * size * size float, 배치 슬롯 등) 에 직접 채운다
+    LetterboxInfo process(const cv::Mat &frame, float *dst);
+
+private:
+    void updateGeometry(const cv::Size &source);
+
+    int size;
+    cv::Mat blob;       // (1, 3, size, size) CV_32F
+    cv::Mat canvas;     // size x size CV_8UC3, 패딩(114)은 지오메트리가 바뀔 때만 채움
+    cv::Size source;    // 마지막 원본 크기
+    cv::Rect roi;       // canvas 안에서 리사이즈된 이미지 영역
+    LetterboxInfo info;
+};
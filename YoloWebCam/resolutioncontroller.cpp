@@ -0,0 +1,88 @@
+// resolutioncontroller.cpp
+#include "resolutioncontroller.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+const int kLadder[] = { 320, 416, 512, 640, 768, 896, 1024, 1280 };
+const int kWarmupSamples = 2;   // 크기가 바뀐 직후 forward 는 레이어 재할당이 섞여 느리므로 버림
+const int kDownAfter = 5;       // 이만큼 연속으로 예산을 넘기면 한 칸 내림
+const int kUpAfter = 30;        // 이만큼 연속으로 다음 크기에서도 여유가 있으면 한 칸 올림
+const double kUpMargin = 0.8;   // 다음 크기의 예상 시간이 예산의 80% 이하일 때만 여유로 본다
+const double kAlpha = 0.2;
+
+} // namespace
+
+ResolutionController::ResolutionController()
+    : ladder(std::begin(kLadder), std::end(kLadder))
+    , budgetMs(0)
+    , current(640)
+    , average(0)
+    , samples(0)
+    , overBudget(0)
+    , headroom(0)
+{
+}
+
+void ResolutionController::configure(double budget, int minSize, int maxSize)
+{
+    budgetMs = budget;
+    ladder.clear();
+    for (int size : kLadder) {
+        if (size >= minSize && size <= maxSize)
+            ladder.push_back(size);
+    }
+    if (ladder.empty())
+        ladder.push_back(640);
+    reset(current);
+}
+
+int ResolutionController::ladderIndex(int size) const
+{
+    // 사다리에 없는 크기면 가장 가까운 칸
+    int best = 0;
+    for (int i = 1; i < int(ladder.size()); ++i) {
+        if (std::abs(ladder[i] - size) < std::abs(ladder[best] - size))
+            best = i;
+    }
+    return best;
+}
+
+void ResolutionController::reset(int size)
+{
+    // 켜져 있으면 사다리 위의 크기로만 움직인다
+    current = budgetMs > 0 ? ladder[ladderIndex(size)] : size;
+    average = 0;
+    samples = 0;
+    overBudget = 0;
+    headroom = 0;
+}
+
+int ResolutionController::update(double forwardMs)
+{
+    if (budgetMs <= 0)
+        return current;
+
+    if (++samples <= kWarmupSamples)
+        return current;
+    average = samples == kWarmupSamples + 1 ? forwardMs : average + kAlpha * (forwardMs - average);
+
+    const int index = ladderIndex(current);
+
+    // 🔥 내리기: 한 번 튄 것은 무시하고 연속으로 넘길 때만
+    overBudget = forwardMs > budgetMs && average > budgetMs ? overBudget + 1 : 0;
+    if (overBudget >= kDownAfter && index > 0) {
+        reset(ladder[index - 1]);
+        return current;
+    }
+
+    // 🔥 올리기: forward 시간은 입력 면적에 비례한다고 보고 다음 크기의 예상 시간으로 판단
+    if (index + 1 < int(ladder.size())) {
+        const double ratio = double(ladder[index + 1]) / current;
+        headroom = average * ratio * ratio < budgetMs * kUpMargin ? headroom + 1 : 0;
+        if (headroom >= kUpAfter)
+            reset(ladder[index + 1]);
+    }
+    return current;
+}
@@ -0,0 +1,35 @@
+// resolutioncontroller.h
+#pragma once
+#include <vector>
+
+// 지연 시간 예산에 맞춰 입력 크기를 고르는 컨트롤러 (워커마다 하나, 워커 스레드에서만 사용).
+// 크기는 stride 32 배수 사다리 (320 ... 1280) 에서 한 칸씩 움직이고,
+// 예산을 넘기면 몇 번 만에 내리고, 다음 크기로도 여유가 충분할 때만 오래 지켜본 뒤 올린다 (히스테리시스)
+class ResolutionController
+{
+public:
+    ResolutionController();
+
+    // budgetMs <= 0 이면 꺼짐 (크기 고정)
+    void configure(double budgetMs, int minSize, int maxSize);
+    bool isEnabled() const { return budgetMs > 0; }
+
+    // 외부에서 크기를 정했을 때 (모델 교체 등) 그 크기부터 다시 측정 (켜져 있으면 가장 가까운 사다리 크기)
+    void reset(int size);
+
+    // 프레임 한 장당 forward 시간 (배치면 배치 시간 / 장 수) 을 넣고, 다음 배치에 쓸 입력 크기를 돌려준다
+    int update(double forwardMs);
+
+    int inputSize() const { return current; }
+
+private:
+    int ladderIndex(int size) const;
+
+    std::vector<int> ladder;
+    double budgetMs;
+    int current;
+    double average;      // forward 시간 EMA
+    int samples;         // 현재 크기에서 받은 측정 수
+    int overBudget;      // 연속으로 예산을 넘긴 횟수
+    int headroom;        // 연속으로 다음 크기까지 여유가 있던 횟수
+};
@@ -0,0 +1,153 @@
+// streamrecorder.cpp
+#include "streamrecorder.h"
+#include "tracing.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <algorithm>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/videoio.hpp>
+
+StreamRecorder::StreamRecorder(const RecordSettings &recordSettings, QObject *parent)
+    : QObject(parent)
+    , settings(recordSettings)
+    , recording(false)
+    , recorded(0)
+    , dropped(0)
+{
+    settings.queueCapacity = qMax(1, settings.queueCapacity);
+    if (settings.fourcc.size() != 4)
+        settings.fourcc = "MJPG";
+    if (settings.fps <= 0)
+        settings.fps = 30;
+}
+
+StreamRecorder::~StreamRecorder()
+{
+    stop();
+}
+
+QString StreamRecorder::start(const QMap<int, QString> &classNames)
+{
+    if (recording)
+        return videoPath;
+
+    QDir dir(settings.directory.isEmpty() ? QDir::currentPath() : settings.directory);
+    if (!dir.mkpath("."))
+        return QString();
+
+    videoPath = dir.filePath("record_" + QDateTime::currentDateTime().toString("yyyyMMddHHmmss") + ".avi");
+    recorded = 0;
+    dropped = 0;
+    queue.reset(new BoundedQueue<Item>(settings.queueCapacity));
+    writer = std::thread(&StreamRecorder::writeLoop, this, videoPath, classNames);
+    recording = true;
+    return videoPath;
+}
+
+void StreamRecorder::stop()
+{
+    if (!recording)
+        return;
+
+    // 남은 프레임까지 다 쓰고 파일을 닫는다
+    recording = false;
+    queue->close();
+    writer.join();
+    queue.reset();
+    emit finished(videoPath, recorded.load(), dropped);
+}
+
+bool StreamRecorder::record(const FramePtr &frame, const std::vector<Detection> &detections)
+{
+    if (!recording || !frame || frame->image.empty())
+        return false;
+
+    Item item{ frame, detections };
+    // 🔥 Drop: 녹화가 밀려도 라이브 파이프라인은 기다리지 않는다 / Block: 무손실, 대신 호출한 스레드가 기다림
+    const bool queued = settings.overflow == RecordSettings::Block ? queue->push(item) : queue->tryPush(item);
+    if (!queued)
+        dropped++;
+    return queued;
+}
+
+void StreamRecorder::writeLoop(const QString &path, const QMap<int, QString> &classNames)
+{
+    TRACE_THREAD_NAME("recorder");
+
+    QFileInfo info(path);
+    QFile sidecar(info.dir().filePath(info.completeBaseName() + ".timestamps.txt"));
+    const bool sidecarOpen = sidecar.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text);
+    QTextStream timestamps(&sidecar);
+
+    cv::VideoWriter video;
+    cv::Size frameSize;
+    cv::Mat canvas;
+    qint64 firstTimestampUs = 0;
+    quint64 index = 0;
+    bool ok = true;
+
+    Item item;
+    while (queue->pop(item)) {
+        TRACE_SCOPE("recorder.write", item.frame->sequence);
+
+        // 첫 프레임 크기로 파일을 연다
+        if (!video.isOpened()) {
+            if (!ok)
+                continue;   // 열기에 실패했으면 남은 프레임은 버리며 대기열만 비운다
+            frameSize = item.frame->image.size();
+            const QByteArray fourcc = settings.fourcc.toLatin1();
+            ok = video.open(path.toStdString(), cv::VideoWriter::fourcc(fourcc[0], fourcc[1], fourcc[2], fourcc[3]),
+                            settings.fps, frameSize, true);
+            if (!ok)
+                continue;
+            firstTimestampUs = item.frame->timestampUs;
+        }
+
+        // 소스 해상도가 바뀌면 첫 크기에 맞춘다. 박스는 녹화 스레드 소유의 canvas에만 그림
+        // ⚠️ canvas가 풀 버퍼를 가리키면 안 된다: 풀로 돌아간 뒤 다른 크기 연산이 캡처 중인 버퍼에 씀
+        const cv::Mat &source = item.frame->image;
+        const bool annotate = settings.content == RecordSettings::Annotated && !item.detections.empty();
+        const cv::Mat *out = &source;
+        if (source.size() != frameSize) {
+            cv::resize(source, canvas, frameSize);
+            out = &canvas;
+        } else if (annotate) {
+            source.copyTo(canvas);
+            out = &canvas;
+        }
+
+        if (annotate) {
+            const double sx = double(frameSize.width) / source.cols;
+            const double sy = double(frameSize.height) / source.rows;
+            for (const Detection &det : item.detections) {
+                const cv::Rect box(cvRound(det.box.x * sx), cvRound(det.box.y * sy),
+                                   cvRound(det.box.width * sx), cvRound(det.box.height * sy));
+                cv::rectangle(canvas, box, cv::Scalar(0, 0, 255), 2);
+
+                const QString name = classNames.contains(det.classId) ? classNames[det.classId] : QString::number(det.classId);
+                QString label = QString("%1 %2").arg(name).arg(det.confidence, 0, 'f', 2);
+                if (det.trackId > 0)
+                    label.prepend(QString("#%1 ").arg(det.trackId));
+                const std::string text = label.toStdString();
+                cv::putText(canvas, text, cv::Point(box.x, std::max(box.y - 4, 12)),
+                            cv::FONT_HERSHEY_SIMPLEX, 0.5, cv::Scalar(0, 0, 255), 1);
+            }
+        }
+
+        video.write(*out);
+        if (sidecarOpen)
+            timestamps << index << ' ' << (item.frame->timestampUs - firstTimestampUs) / 1000 << '\n';
+        index++;
+        recorded++;
+        item = Item();   // 프레임 버퍼를 바로 풀로 돌려준다
+    }
+
+    video.release();
+    timestamps.flush();
+    if (!ok)
+        emit failed(path);
+}
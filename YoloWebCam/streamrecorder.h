@@ -0,0 +1,72 @@
+// streamrecorder.h
+#pragma once
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "boundedqueue.h"
+#include "framepool.h"
+#include "yolodecoder.h"
+
+// 녹화 설정
+struct RecordSettings {
+    enum Content { Annotated, Raw };
+    enum Overflow { Drop, Block };
+
+    Content content = Annotated;   // 추론 결과 (박스 포함) 또는 캡처 원본
+    Overflow overflow = Drop;      // 대기열이 차면 그 프레임을 버림 / 자리가 날 때까지 호출한 스레드를 멈춤 (무손실)
+    int queueCapacity = 32;        // 인코딩 대기 프레임 상한 (메모리 상한 = 이 개수 만큼의 프레임 버퍼)
+    QString fourcc = "MJPG";
+    double fps = 30;               // 컨테이너에 기록할 재생 FPS (실제 간격은 타임스탬프 파일에)
+    QString directory;             // 비어 있으면 현재 작업 폴더
+};
+
+// 화면에 보이는 스트림을 전용 스레드에서 cv::VideoWriter 로 녹화한다.
+// 프레임은 공유 버퍼 그대로 대기열에 넣고 박스 그리기 / 인코딩은 모두 녹화 스레드에서 하므로,
+// Drop 정책이면 라이브 파이프라인에는 대기열에 넣는 비용만 든다.
+// 프레임마다 캡처 시각을 <이름>.timestamps.txt ("<index> <ms>") 에 남겨 FileSource 로 같은 간격 그대로 재생할 수 있다
+class StreamRecorder : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit StreamRecorder(const RecordSettings &settings = RecordSettings(), QObject *parent = nullptr);
+    ~StreamRecorder();
+
+    // 녹화 시작, 만든 동영상 경로를 돌려준다 (실패하면 빈 문자열)
+    QString start(const QMap<int, QString> &classNames);
+    void stop();
+    bool isRecording() const { return recording; }
+
+    RecordSettings::Content content() const { return settings.content; }
+
+    // 프레임 하나 추가 (GUI 스레드). Drop 정책에서 대기열이 차 있으면 false
+    bool record(const FramePtr &frame, const std::vector<Detection> &detections = std::vector<Detection>());
+
+    quint64 recordedCount() const { return recorded.load(); }
+    quint64 droppedCount() const { return dropped; }
+    int pendingCount() const { return queue ? queue->size() : 0; }
+
+signals:
+    void finished(const QString &path, quint64 recordedFrames, quint64 droppedFrames);
+    void failed(const QString &path);
+
+private:
+    struct Item {
+        FramePtr frame;
+        std::vector<Detection> detections;
+    };
+
+    void writeLoop(const QString &videoPath, const QMap<int, QString> &classNames);
+
+    RecordSettings settings;
+    std::unique_ptr<BoundedQueue<Item>> queue;
+    std::thread writer;
+    bool recording;
+    QString videoPath;
+    std::atomic<quint64> recorded;
+    quint64 dropped;
+};
@@ -0,0 +1,147 @@
+// tileddetector.cpp
+#include "tileddetector.h"
+#include <algorithm>
+
+namespace {
+
+const float kContainedRatio = 0.8f;  // 작은 조각 면적의 80% 이상이 큰 박스 안이면 같은 물체의 잘린 조각으로 본다
+const float kEdgeMargin = 2.f;       // 타일 경계에서 이 픽셀 안이면 경계에 닿은 것으로 본다
+
+// 박스가 프레임 가장자리가 아닌 (이웃 타일과 맞닿은) 타일 경계에 닿았는지
+bool touchesSeam(const cv::Rect2f &box, const cv::Rect &tile, const cv::Size &frame)
+{
+    return (tile.x > 0 && box.x <= tile.x + kEdgeMargin)
+           || (tile.y > 0 && box.y <= tile.y + kEdgeMargin)
+           || (tile.x + tile.width < frame.width && box.x + box.width >= tile.x + tile.width - kEdgeMargin)
+           || (tile.y + tile.height < frame.height && box.y + box.height >= tile.y + tile.height - kEdgeMargin);
+}
+
+std::vector<int> axisStarts(int length, int tile, int stride)
+{
+    std::vector<int> starts;
+    if (length <= tile) {
+        starts.push_back(0);
+        return starts;
+    }
+    for (int start = 0; start + tile < length; start += stride)
+        starts.push_back(start);
+    starts.push_back(length - tile);
+    return starts;
+}
+
+} // namespace
+
+TiledDetector::TiledDetector(BatchDetector &detector)
+    : detector(detector)
+{
+}
+
+std::vector<cv::Rect> TiledDetector::makeTiles(const cv::Size &frame, int tileSize, double overlap)
+{
+    const int tile = std::max(32, tileSize);
+    const int stride = std::max(1, int(tile * (1.0 - std::min(std::max(overlap, 0.0), 0.9))));
+
+    std::vector<cv::Rect> result;
+    for (int y : axisStarts(frame.height, tile, stride)) {
+        for (int x : axisStarts(frame.width, tile, stride))
+            result.push_back(cv::Rect(x, y, std::min(tile, frame.width), std::min(tile, frame.height)));
+    }
+    return result;
+}
+
+void TiledDetector::merge(std::vector<Detection> &detections, const std::vector<bool> &fragments, float iouThreshold)
+{
+    std::vector<int> order(detections.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = int(i);
+    std::sort(order.begin(), order.end(), [&detections](int a, int b) {
+        return detections[a].confidence > detections[b].confidence;
+    });
+
+    std::vector<Detection> kept;
+    std::vector<bool> keptFragment;
+    kept.reserve(detections.size());
+    for (int index : order) {
+        const Detection &det = detections[index];
+        const bool fragment = index < int(fragments.size()) && fragments[index];
+        const float area = det.box.area();
+        bool duplicate = false;
+        for (size_t k = 0; k < kept.size(); ++k) {
+            Detection &other = kept[k];
+            if (other.classId != det.classId)
+                continue;
+            const float inter = (det.box & other.box).area();
+            if (inter <= 0)
+                continue;
+            const float iou = inter / (area + other.box.area() - inter);
+            const bool smallerIsFragment = area < other.box.area() ? fragment : keptFragment[k];
+            const float contained = inter / std::max(1e-6f, std::min(area, other.box.area()));
+            if (smallerIsFragment && contained > kContainedRatio) {
+                // 타일 경계 조각이 온전한 박스보다 점수가 높아도 잘린 박스가 남지 않게 합친다
+                other.box |= det.box;
+                keptFragment[k] = keptFragment[k] && fragment;
+                duplicate = true;
+                break;
+            }
+            if (iou > iouThreshold) {
+                if (area > other.box.area()) {
+                    other.box = det.box;
+                    keptFragment[k] = fragment;
+                }
+                duplicate = true;
+                break;
+            }
+        }
+        if (!duplicate) {
+            kept.push_back(det);
+            keptFragment.push_back(fragment);
+        }
+    }
+    detections.swap(kept);
+}
+
+void TiledDetector::detect(const cv::Mat &frame, std::vector<Detection> &detections)
+{
+    detections.clear();
+    fragments.clear();
+    if (frame.empty())
+        return;
+
+    regions = makeTiles(frame.size(), tiles.tileSize, tiles.overlap);
+    if (tiles.globalPass && regions.size() > 1)
+        regions.push_back(cv::Rect(0, 0, frame.cols, frame.rows));
+
+    // 🔥 타일은 ROI 헤더라 복사 없이 배치 슬롯에 바로 레터박스 (타일 크기 = 입력 크기면 축소도 없음)
+    const int total = int(regions.size());
+    int chunk = tiles.tilesPerForward > 0 ? tiles.tilesPerForward : total;
+    if (!detector.isDynamic())
+        chunk = 1;   // 고정 shape 모델은 타일을 한 장씩
+    const cv::Rect2f bounds(0.f, 0.f, float(frame.cols), float(frame.rows));
+    for (int first = 0; first < total; first += chunk) {
+        const int count = std::min(chunk, total - first);
+        detector.reserve(count);
+        letterboxes.resize(count);
+        for (int i = 0; i < count; ++i)
+            letterboxes[i] = detector.prepare(i, frame(regions[first + i]));
+
+        detector.run(count, results);
+
+        // 네트워크 입력 좌표 → 타일 좌표 → 원본 좌표
+        for (int i = 0; i < count; ++i) {
+            const cv::Rect &region = regions[first + i];
+            const cv::Point2f offset(float(region.x), float(region.y));
+            for (Detection det : results[i]) {
+                det.box = letterboxes[i].toSource(det.box);
+                det.box.x += offset.x;
+                det.box.y += offset.y;
+                det.box &= bounds;
+                if (det.box.area() > 0) {
+                    detections.push_back(det);
+                    fragments.push_back(touchesSeam(det.box, region, frame.size()));
+                }
+            }
+        }
+    }
+
+    merge(detections, fragments, tiles.mergeIou);
+}
@@ -0,0 +1,47 @@
+// tileddetector.h
+#pragma once
+#include <vector>
+#include <opencv2/core.hpp>
+#include "batchdetector.h"
+
+// 타일 추론 설정
+struct TileSettings {
+    bool enabled = false;
+    int tileSize = 640;          // 원본 프레임에서 자르는 타일 크기 (입력 크기와 같으면 타일은 축소 없이 들어간다)
+    double overlap = 0.2;        // 이웃 타일끼리 겹치는 비율 (경계에 걸친 물체가 어느 한 타일에는 온전히 들어가게)
+    bool globalPass = true;      // 프레임 전체를 한 장 더 (큰 물체용)
+    int tilesPerForward = 1;     // forward 한 번에 넣을 타일 수 (0 이면 한 프레임의 타일 전부를 한 배치로, dynamic batch 모델 필요)
+    float mergeIou = 0.5f;       // 타일 간 중복 제거 IoU
+};
+
+// 고해상도 프레임을 겹치는 타일로 잘라 (원본 그대로, 축소 없이) 배치 forward 하고,
+// 타일 좌표 → 원본 좌표로 옮긴 뒤 타일 경계에서 잘린 박스까지 클래스별로 합친다.
+// BatchDetector 를 빌려 쓰므로 같은 스레드에서만 사용
+class TiledDetector
+{
+public:
+    explicit TiledDetector(BatchDetector &detector);
+
+    void setSettings(const TileSettings &settings) { tiles = settings; }
+    const TileSettings &settings() const { return tiles; }
+
+    // 프레임 한 장 → 원본 좌표 검출
+    void detect(const cv::Mat &frame, std::vector<Detection> &detections);
+
+    // 프레임을 덮는 타일 영역 (마지막 줄 / 칸은 가장자리에 붙인다)
+    static std::vector<cv::Rect> makeTiles(const cv::Size &frame, int tileSize, double overlap);
+
+    // 클래스별로 점수 순 탐욕 병합: IoU 가 threshold 를 넘으면 같은 물체로 보고 점수는 높은 쪽, 박스는 큰 쪽을 남긴다.
+    // fragments[i] 는 i 번째 박스가 자기 타일의 안쪽 경계 (이웃 타일과 맞닿은 쪽) 에 닿아 잘렸을 수 있다는 표시로,
+    // 작은 쪽이 그런 조각이고 거의 다 겹칠 때만 합집합으로 붙인다 (멀리 있는 사람 / 겹쳐 선 차는 IoU 로만 판단)
+    static void merge(std::vector<Detection> &detections, const std::vector<bool> &fragments, float iouThreshold);
+
+private:
+    BatchDetector &detector;
+    TileSettings tiles;
+
+    std::vector<cv::Rect> regions;        // 이번 프레임의 타일 (+ 전체 프레임)
+    std::vector<LetterboxInfo> letterboxes;
+    std::vector<std::vector<Detection>> results;
+    std::vector<bool> fragments;          // detections 와 같은 순서, 타일 안쪽 경계에 닿은 박스
+};
@@ -0,0 +1,135 @@
+// tracing.cpp
+#include "tracing.h"
+#include "framepool.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QTextStream>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Trace {
+
+namespace {
+
+struct Event {
+    const char *name;
+    quint64 frameId;
+    qint64 startUs;
+    qint64 endUs;
+};
+
+const quint64 kCapacity = 1 << 16;  // 스레드당 최근 65536 구간
+
+struct ThreadBuffer {
+    int tid = 0;
+    std::string threadName;
+    std::vector<Event> events;
+    std::atomic<quint64> head{0};   // 지금까지 기록한 개수 (링 버퍼 위치 = head % kCapacity)
+};
+
+// 버퍼는 스레드가 끝나도 dump 할 수 있게 레지스트리가 소유한다
+std::mutex registryMutex;
+std::vector<std::shared_ptr<ThreadBuffer>> registry;
+thread_local ThreadBuffer *current = nullptr;
+
+ThreadBuffer *threadBuffer()
+{
+    if (!current) {
+        std::shared_ptr<ThreadBuffer> buffer = std::make_shared<ThreadBuffer>();
+        buffer->events.resize(kCapacity);
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffer->tid = int(registry.size()) + 1;
+        registry.push_back(buffer);
+        current = buffer.get();
+    }
+    return current;
+}
+
+} // namespace
+
+void record(const char *name, quint64 frameId, qint64 startUs, qint64 endUs)
+{
+    ThreadBuffer *buffer = threadBuffer();
+    const quint64 index = buffer->head.load(std::memory_order_relaxed);
+    Event &event = buffer->events[index % kCapacity];
+    event.name = name;
+    event.frameId = frameId;
+    event.startUs = startUs;
+    event.endUs = endUs;
+    buffer->head.store(index + 1, std::memory_order_release);
+}
+
+void setThreadName(const char *name)
+{
+    ThreadBuffer *buffer = threadBuffer();
+    if (buffer->threadName == name)  // 이름은 소유 스레드만 바꾸므로 비교는 락 없이
+        return;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer->threadName = name;
+}
+
+Span::Span(const char *name, quint64 frameId)
+    : name(name), frameId(frameId), startUs(frameClockUs())
+{
+}
+
+Span::~Span()
+{
+    record(name, frameId, startUs, frameClockUs());
+}
+
+bool dump(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        return false;
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffers = registry;
+    }
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QTextStream out(&file);
+    out << "{\"traceEvents\":[\n";
+    bool first = true;
+
+    for (const std::shared_ptr<ThreadBuffer> &buffer : buffers) {
+        std::string threadName;
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            threadName = buffer->threadName;
+        }
+        if (!threadName.empty()) {
+            out << (first ? "" : ",\n")
+                << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << pid << ",\"tid\":" << buffer->tid
+                << ",\"args\":{\"name\":\"" << threadName.c_str() << "\"}}";
+            first = false;
+        }
+
+        // 기록 중인 스레드와 겹칠 수 있는 가장 오래된 구간 일부는 건너뛴다
+        const quint64 head = buffer->head.load(std::memory_order_acquire);
+        const quint64 margin = 256;
+        const quint64 begin = head > kCapacity - margin ? head - (kCapacity - margin) : 0;
+        for (quint64 i = begin; i < head; ++i) {
+            const Event &event = buffer->events[i % kCapacity];
+            out << (first ? "" : ",\n")
+                << "{\"ph\":\"X\",\"name\":\"" << event.name << "\",\"pid\":" << pid << ",\"tid\":" << buffer->tid
+                << ",\"ts\":" << event.startUs << ",\"dur\":" << (event.endUs - event.startUs)
+                << ",\"args\":{\"frame\":" << event.frameId << "}}";
+            first = false;
+        }
+    }
+
+    out << "\n]}\n";
+    return true;
+}
+
+} // namespace Trace
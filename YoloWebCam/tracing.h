@@ -0,0 +1,44 @@
+// tracing.h
+#pragma once
+#include <QString>
+#include <QtGlobal>
+
+// 핫패스 추적 (Chrome trace-event JSON).
+// qmake CONFIG+=trace 로 빌드할 때만 YOLO_TRACE 가 정의되고, 아니면 매크로가 전부 비어서 비용이 0 이다.
+//
+//   TRACE_SCOPE("inference.forward", frame->sequence);   // 블록이 끝날 때까지의 구간
+//   TRACE_THREAD_NAME("capture");                          // trace viewer 에 보일 스레드 이름
+//   Trace::dump("trace.json");                             // chrome://tracing, Perfetto 에서 열기
+
+namespace Trace {
+
+// 스레드마다 자기 링 버퍼에 기록한다 (기록 경로에 락 없음)
+void record(const char *name, quint64 frameId, qint64 startUs, qint64 endUs);
+void setThreadName(const char *name);
+
+// 지금까지 모든 스레드에 쌓인 구간을 JSON 으로 저장
+bool dump(const QString &path);
+
+class Span
+{
+public:
+    Span(const char *name, quint64 frameId);
+    ~Span();
+
+private:
+    const char *name;
+    quint64 frameId;
+    qint64 startUs;
+};
+
+} // namespace Trace
+
+#ifdef YOLO_TRACE
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name, frameId) Trace::Span TRACE_CONCAT(traceSpan, __LINE__)(name, frameId)
+#define TRACE_THREAD_NAME(name) Trace::setThreadName(name)
+#else
+#define TRACE_SCOPE(name, frameId) do { (void)(frameId); } while (0)
+#define TRACE_THREAD_NAME(name) do {} while (0)
+#endif
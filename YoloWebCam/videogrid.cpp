@@ -0,0 +1,102 @@
+// videogrid.cpp
+#include "videogrid.h"
+#include "framepool.h"
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <algorithm>
+#include <cmath>
+
+VideoGrid::VideoGrid(QWidget *parent)
+    : QWidget(parent), selected(-1), dirty(false)
+{
+    setMinimumHeight(120);
+
+    // 🔥 최대 30 Hz 로만 다시 그림 (소스 수와 무관하게 GUI 부하 일정)
+    repaintTimer.setInterval(33);
+    connect(&repaintTimer, &QTimer::timeout, this, [this]() {
+        if (dirty) {
+            dirty = false;
+            update();
+        }
+    });
+    repaintTimer.start();
+}
+
+void VideoGrid::setSourceIds(const QList<int> &sourceIds)
+{
+    ids = sourceIds;
+    dirty = true;
+}
+
+void VideoGrid::setFrame(int sourceId, const QImage &image, const QVector<OverlayBox> &boxes, const QString &caption)
+{
+    Tile &tile = tiles[sourceId];
+    tile.image = image;
+    tile.boxes = boxes;
+    tile.caption = caption;
+    tile.displayRate.tick(frameClockUs());
+    dirty = true;
+}
+
+void VideoGrid::setSelected(int sourceId)
+{
+    selected = sourceId;
+    dirty = true;
+}
+
+int VideoGrid::columns() const
+{
+    return std::max(1, int(std::ceil(std::sqrt(double(ids.size())))));
+}
+
+QRect VideoGrid::cellRect(int index) const
+{
+    const int cols = columns();
+    const int rows = std::max(1, (int(ids.size()) + cols - 1) / cols);
+    const int w = width() / cols;
+    const int h = height() / rows;
+    return QRect((index % cols) * w, (index / cols) * h, w, h);
+}
+
+void VideoGrid::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), Qt::black);
+    const qint64 now = frameClockUs();
+
+    for (int i = 0; i < ids.size(); ++i) {
+        const QRect cell = cellRect(i).adjusted(1, 1, -1, -1);
+        auto it = tiles.find(ids[i]);
+        if (it != tiles.end() && !it->image.isNull()) {
+            // 작은 칸이라 FastTransformation 으로 충분
+            QSize size = it->image.size().scaled(cell.size(), Qt::KeepAspectRatio);
+            QRect target(QPoint(0, 0), size);
+            target.moveCenter(cell.center());
+            painter.drawImage(target, it->image);
+
+            const double scale = double(target.width()) / it->image.width();
+            painter.setPen(QPen(Qt::red, 1));
+            for (const OverlayBox &box : it->boxes)
+                painter.drawRect(QRectF(target.left() + box.rect.x() * scale, target.top() + box.rect.y() * scale,
+                                        box.rect.width() * scale, box.rect.height() * scale));
+
+            painter.setPen(Qt::yellow);
+            painter.drawText(cell.adjusted(4, 2, -4, -2), Qt::AlignLeft | Qt::AlignTop,
+                             QString("#%1  %2 fps  %3").arg(ids[i]).arg(it->displayRate.rate(now), 0, 'f', 1).arg(it->caption));
+        }
+        painter.setPen(ids[i] == selected ? QPen(Qt::green, 2) : QPen(Qt::darkGray, 1));
+        painter.drawRect(cell);
+    }
+}
+
+void VideoGrid::mousePressEvent(QMouseEvent *event)
+{
+    for (int i = 0; i < ids.size(); ++i) {
+        if (cellRect(i).contains(event->pos())) {
+            emit sourceSelected(ids[i]);
+            return;
+        }
+    }
+    QWidget::mousePressEvent(event);
+}
@@ -0,0 +1,49 @@
+// videogrid.h
+#pragma once
+#include <QImage>
+#include <QMap>
+#include <QString>
+#include <QTimer>
+#include <QWidget>
+#include <QVector>
+#include "imagelabel.h"
+#include "pipelinestats.h"
+
+// 여러 소스의 최신 결과를 격자로 보여주는 위젯.
+// setFrame 은 이미지만 바꿔 두고, 그리기는 타이머로 모아서 한 번에 → 빠른 소스가 GUI 를 독차지하지 않는다
+class VideoGrid : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit VideoGrid(QWidget *parent = nullptr);
+
+    void setSourceIds(const QList<int> &ids);
+    // boxes 는 image 좌표계 (그릴 때 칸 크기에 맞춰 변환)
+    void setFrame(int sourceId, const QImage &image, const QVector<OverlayBox> &boxes, const QString &caption);
+    void setSelected(int sourceId);
+
+signals:
+    void sourceSelected(int sourceId);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+
+private:
+    struct Tile {
+        QImage image;
+        QVector<OverlayBox> boxes;
+        QString caption;
+        RateMeter displayRate;
+    };
+
+    QRect cellRect(int index) const;
+    int columns() const;
+
+    QList<int> ids;
+    QMap<int, Tile> tiles;
+    int selected;
+    bool dirty;
+    QTimer repaintTimer;
+};
@@ -1,8 +1,9 @@
 #include "webcamworker.h"
+#include "tracing.h"
 #include <QThread>
 
-WebcamWorker::WebcamWorker(QObject *parent)
-    : QObject(parent), running(false)
+WebcamWorker::WebcamWorker(int sourceId, QObject *parent)
+    : FrameSource(sourceId, parent)
 {
 }
 
@@ -11,38 +12,92 @@ WebcamWorker::~WebcamWorker()
     stop();
 }
 
-void WebcamWorker::start()
+void WebcamWorker::setSettings(const CaptureSettings &captureSettings)
+{
+    settings = captureSettings;
+}
+
+bool WebcamWorker::openDevice()
 {
-    if (running) return;
+    // V4L2 우선, 안 되면 OpenCV 기본 백엔드
+    if (!cap.open(settings.device, cv::CAP_V4L2) && !cap.open(settings.device))
+        return false;
 
-    running = true;
-    cap.open(0); // 0번 카메라 열기
+    // 🔥 포맷 → 해상도 → FPS 순서로 협상 (V4L2 는 포맷에 따라 가능한 해상도/FPS 가 달라짐)
+    if (settings.pixelFormat.size() == 4) {
+        const QByteArray fourcc = settings.pixelFormat.toLatin1();
+        cap.set(cv::CAP_PROP_FOURCC, cv::VideoWriter::fourcc(fourcc[0], fourcc[1], fourcc[2], fourcc[3]));
+    }
+    if (settings.width > 0 && settings.height > 0) {
+        cap.set(cv::CAP_PROP_FRAME_WIDTH, settings.width);
+        cap.set(cv::CAP_PROP_FRAME_HEIGHT, settings.height);
+    }
+    if (settings.fps > 0)
+        cap.set(cv::CAP_PROP_FPS, settings.fps);
 
-    if (!cap.isOpened()) {
-        qWarning("Failed to open webcam.");
+    cap.set(cv::CAP_PROP_BUFFERSIZE, 1); // 드라이버 큐에 오래된 프레임이 쌓이지 않게
+
+    const int fourcc = int(cap.get(cv::CAP_PROP_FOURCC));
+    qDebug("Webcam %d: %dx%d @ %.1f fps, format %c%c%c%c", settings.device,
+           int(cap.get(cv::CAP_PROP_FRAME_WIDTH)), int(cap.get(cv::CAP_PROP_FRAME_HEIGHT)),
+           cap.get(cv::CAP_PROP_FPS),
+           fourcc & 0xff, (fourcc >> 8) & 0xff, (fourcc >> 16) & 0xff, (fourcc >> 24) & 0xff);
+    return true;
+}
+
+void WebcamWorker::start()
+{
+    if (running.exchange(true)) return;
+
+    if (!openDevice()) {
+        qWarning("Failed to open webcam %d.", settings.device);
         running = false;
         return;
     }
 
+    // MJPEG 축소 디코딩: 드라이버 변환을 끄고 압축 데이터를 받아 imdecode 에서 1/2, 1/4, 1/8 로 바로 디코딩
+    int decodeFlags = cv::IMREAD_COLOR;
+    switch (settings.decodeScale) {
+    case 2: decodeFlags = cv::IMREAD_REDUCED_COLOR_2; break;
+    case 4: decodeFlags = cv::IMREAD_REDUCED_COLOR_4; break;
+    case 8: decodeFlags = cv::IMREAD_REDUCED_COLOR_8; break;
+    default: break;
+    }
+    const bool rawMjpeg = settings.pixelFormat == "MJPG" && decodeFlags != cv::IMREAD_COLOR
+                          && cap.set(cv::CAP_PROP_CONVERT_RGB, 0);
+    cv::Mat raw;
+    TRACE_THREAD_NAME("capture");
+
     while (running) {
-        cv::Mat frame;
-        cap >> frame;
-        if (frame.empty())
-            continue;
+        const quint64 frameId = sequence + 1;
 
-        cv::cvtColor(frame, frame, cv::COLOR_BGR2RGB);
-        QImage image(frame.data, frame.cols, frame.rows, frame.step, QImage::Format_RGB888);
+        // 🔥 장치에서 프레임이 도착할 때까지 grab 이 블록 → 고정 sleep 없이 장치 속도로 페이싱
+        bool grabbed;
+        {
+            TRACE_SCOPE("capture.grab", frameId);
+            grabbed = cap.grab();
+        }
+        if (!grabbed) {
+            QThread::msleep(5);
+            continue;
+        }
+        const qint64 timestamp = frameClockUs();
+        TRACE_SCOPE("capture.retrieve", frameId);
 
-        emit frameReady(image.copy()); // QImage 복사해서 보내기
+        // 풀에서 받은 버퍼에 바로 디코딩 (BGR 그대로, 변환/복사 없음)
+        std::shared_ptr<Frame> frame = pool.acquire();
+        if (rawMjpeg) {
+            if (!cap.retrieve(raw) || raw.empty())
+                continue;
+            cv::imdecode(raw, decodeFlags, &frame->image);
+        } else if (!cap.retrieve(frame->image)) {
+            continue;
+        }
+        if (frame->image.empty())
+            continue;
 
-        QThread::msleep(30); // 대략 30FPS
+        publish(frame, timestamp);
     }
 
     cap.release();
 }
-
-void WebcamWorker::stop()
-{
-    QMutexLocker locker(&mutex);
-    running = false;
-}
@@ -1,30 +1,38 @@
 #ifndef WEBCAMWORKER_H
 #define WEBCAMWORKER_H
 
-#include <QObject>
-#include <QImage>
-#include <QMutex>
+#include <QString>
 #include <opencv2/opencv.hpp>
+#include "framesource.h"
 
-class WebcamWorker : public QObject
+// 캡처 장치 설정. 0 / 빈 값은 장치 기본값 사용
+struct CaptureSettings {
+    int device = 0;
+    int width = 0;
+    int height = 0;
+    int fps = 0;
+    QString pixelFormat;   // "MJPG", "YUYV"
+    int decodeScale = 1;   // MJPG 일 때 디코딩 단계에서 바로 축소 (1, 2, 4, 8)
+};
+
+class WebcamWorker : public FrameSource
 {
     Q_OBJECT
 
 public:
-    explicit WebcamWorker(QObject *parent = nullptr);
+    explicit WebcamWorker(int sourceId = 0, QObject *parent = nullptr);
     ~WebcamWorker();
 
-public slots:
-    void start();
-    void stop();
+    void setSettings(const CaptureSettings &settings); // start 전에 호출
 
-signals:
-    void frameReady(const QImage &frame);
+public slots:
+    void start() override;
 
 private:
-    bool running;
-    QMutex mutex;
+    bool openDevice();
+
     cv::VideoCapture cap;
+    CaptureSettings settings;
 };
 
 #endif // WEBCAMWORKER_H
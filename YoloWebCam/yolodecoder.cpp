@@ -0,0 +1,154 @@
+// yolodecoder.cpp
+#include "yolodecoder.h"
+#include <algorithm>
+#include <opencv2/core/hal/intrin.hpp>
+
+YoloDecoder::YoloDecoder(float confThreshold, float nmsThreshold, int maxDetections)
+    : confThreshold(confThreshold), nmsThreshold(nmsThreshold), maxDetections(maxDetections)
+{
+    candidates.reserve(1024);
+}
+
+void YoloDecoder::decode(const cv::Mat &output, std::vector<Detection> &detections)
+{
+    detections.clear();
+
+    // (1, 4+nc, N) 형태의 연속된 float 텐서만 처리
+    if (output.empty() || output.dims != 3 || output.type() != CV_32F || !output.isContinuous())
+        return;
+
+    decode(output.ptr<float>(), output.size[1], output.size[2], detections);
+}
+
+void YoloDecoder::decode(const float *data, int channels, int anchors, std::vector<Detection> &detections)
+{
+    detections.clear();
+    candidates.clear();
+
+    const int numClasses = channels - 4;
+    if (numClasses <= 0 || anchors <= 0)
+        return;
+
+    // 행 0~3: cx, cy, w, h / 행 4~: 클래스 점수 (행마다 anchors 개가 연속)
+    collectCandidates(data + 4 * anchors, numClasses, anchors);
+    if (candidates.empty())
+        return;
+
+    runNms(data, anchors, detections);
+}
+
+void YoloDecoder::collectCandidates(const float *scores, int numClasses, int anchors)
+{
+    int i = 0;
+
+#if CV_SIMD
+    // 🔥 채널 우선 레이아웃이라 같은 클래스의 앵커 점수가 연속 → 전치 없이 앵커 lanes 개씩 한 번에 argmax
+    const int lanes = cv::v_float32::nlanes;
+    const cv::v_float32 vThreshold = cv::vx_setall_f32(confThreshold);
+    const cv::v_float32 vOne = cv::vx_setall_f32(1.f);
+    float bestScore[cv::v_float32::nlanes];
+    float bestClass[cv::v_float32::nlanes];
+
+    for (; i <= anchors - lanes; i += lanes) {
+        cv::v_float32 vBest = cv::vx_load(scores + i);
+        cv::v_float32 vBestClass = cv::vx_setzero_f32();
+        cv::v_float32 vClass = cv::vx_setzero_f32();
+
+        for (int c = 1; c < numClasses; ++c) {
+            vClass = vClass + vOne;
+            cv::v_float32 v = cv::vx_load(scores + c * anchors + i);
+            cv::v_float32 greater = v > vBest;   // 동점이면 앞 클래스 유지 (numpy argmax 와 동일)
+            vBest = cv::v_select(greater, v, vBest);
+            vBestClass = cv::v_select(greater, vClass, vBestClass);
+        }
+
+        // 조기 제외: threshold 를 넘는 앵커가 하나도 없으면 스칼라 경로로 내려가지 않는다
+        cv::v_float32 pass = vBest > vThreshold;
+        if (!cv::v_check_any(pass))
+            continue;
+
+        const int mask = cv::v_signmask(pass);
+        cv::v_store(bestScore, vBest);
+        cv::v_store(bestClass, vBestClass);
+        for (int k = 0; k < lanes; ++k) {
+            if (mask & (1 << k))
+                candidates.push_back({ i + k, static_cast<int>(bestClass[k]), bestScore[k] });
+        }
+    }
+    cv::vx_cleanup();
+#endif
+
+    // 나머지 앵커 (또는 SIMD 미지원 빌드) 는 스칼라로 처리
+    for (; i < anchors; ++i) {
+        float best = scores[i];
+        int bestId = 0;
+        for (int c = 1; c < numClasses; ++c) {
+            const float s = scores[c * anchors + i];
+            if (s > best) {
+                best = s;
+                bestId = c;
+            }
+        }
+        if (best > confThreshold)
+            candidates.push_back({ i, bestId, best });
+    }
+}
+
+void YoloDecoder::runNms(const float *data, int anchors, std::vector<Detection> &detections)
+{
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate &a, const Candidate &b) { return a.score > b.score; });
+
+    const size_t n = candidates.size();
+    x1.resize(n);
+    y1.resize(n);
+    x2.resize(n);
+    y2.resize(n);
+    areas.resize(n);
+    suppressed.assign(n, 0);
+
+    // 후보 박스만 cx,cy,w,h → x1,y1,x2,y2 (SoA) 로 변환
+    const float *cx = data;
+    const float *cy = data + anchors;
+    const float *bw = data + 2 * anchors;
+    const float *bh = data + 3 * anchors;
+    for (size_t k = 0; k < n; ++k) {
+        const int a = candidates[k].anchor;
+        x1[k] = cx[a] - bw[a] * 0.5f;
+        y1[k] = cy[a] - bh[a] * 0.5f;
+        x2[k] = cx[a] + bw[a] * 0.5f;
+        y2[k] = cy[a] + bh[a] * 0.5f;
+        areas[k] = bw[a] * bh[a];
+    }
+
+    // 점수 내림차순 greedy NMS (같은 클래스끼리만 억제)
+    for (size_t i = 0; i < n; ++i) {
+        if (suppressed[i])
+            continue;
+
+        const Candidate &keep = candidates[i];
+        Detection det;   // 기본 멤버 초기값이 있어 C++11 에서는 집합체 초기화가 안 된다
+        det.box = cv::Rect2f(x1[i], y1[i], x2[i] - x1[i], y2[i] - y1[i]);
+        det.classId = keep.classId;
+        det.confidence = keep.score;
+        detections.push_back(det);
+        if (static_cast<int>(detections.size()) >= maxDetections)
+            break;
+
+        for (size_t j = i + 1; j < n; ++j) {
+            if (suppressed[j] || candidates[j].classId != keep.classId)
+                continue;
+
+            const float iw = std::min(x2[i], x2[j]) - std::max(x1[i], x1[j]);
+            if (iw <= 0.f)
+                continue;
+            const float ih = std::min(y2[i], y2[j]) - std::max(y1[i], y1[j]);
+            if (ih <= 0.f)
+                continue;
+
+            const float inter = iw * ih;
+            if (inter > nmsThreshold * (areas[i] + areas[j] - inter))
+                suppressed[j] = 1;
+        }
+    }
+}
@@ -0,0 +1,52 @@
+// yolodecoder.h
+#pragma once
+#include <QMetaType>
+#include <vector>
+#include <opencv2/core.hpp>
+
+// 후처리 결과 한 개 (좌표는 decode 단계에서는 네트워크 입력 좌표, emit 시점에는 원본 프레임 좌표)
+struct Detection {
+    cv::Rect2f box;
+    int classId = 0;
+    float confidence = 0.f;
+    int trackId = 0;    // ObjectTracker 트랙 번호 (0 이면 추적 안 함)
+};
+
+Q_DECLARE_METATYPE(Detection)
+
+// YOLOv8 출력 (1, 4+nc, N) 디코더.
+// 채널 우선 레이아웃을 전치하지 않고 앵커 방향으로 SIMD 스캔 → 클래스 argmax + threshold → 클래스별 NMS
+class YoloDecoder
+{
+public:
+    explicit YoloDecoder(float confThreshold = 0.25f, float nmsThreshold = 0.45f, int maxDetections = 300);
+
+    void setConfThreshold(float threshold) { confThreshold = threshold; }
+    void setNmsThreshold(float threshold) { nmsThreshold = threshold; }
+    void setMaxDetections(int count) { maxDetections = count; }
+
+    // output: net.forward 결과 중 첫 번째 텐서. 결과 박스는 네트워크 입력 좌표계
+    void decode(const cv::Mat &output, std::vector<Detection> &detections);
+
+    // 배치 중 한 장 (channels x anchors, 채널 우선) 을 직접 디코딩
+    void decode(const float *data, int channels, int anchors, std::vector<Detection> &detections);
+
+private:
+    struct Candidate {
+        int anchor;
+        int classId;
+        float score;
+    };
+
+    void collectCandidates(const float *scores, int numClasses, int anchors);
+    void runNms(const float *data, int anchors, std::vector<Detection> &detections);
+
+    float confThreshold;
+    float nmsThreshold;
+    int maxDetections;
+
+    // 프레임마다 재사용하는 작업 버퍼 (정상 상태에서는 재할당 없음)
+    std::vector<Candidate> candidates;
+    std::vector<float> x1, y1, x2, y2, areas;
+    std::vector<char> suppressed;
+};
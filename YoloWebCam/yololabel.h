@@ -0,0 +1,63 @@
+// yololabel.h
+#pragma once
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QVector>
+
+// YOLO 라벨 한 줄 (이미지 크기로 정규화된 중심 / 크기)
+struct YoloLabel {
+    int classId = 0;
+    double xCenter = 0;
+    double yCenter = 0;
+    double width = 0;
+    double height = 0;
+};
+
+// YOLO 라벨 한 줄: "class cx cy w h" (이미지 크기로 정규화, 소수점 6자리)
+inline QString formatYoloLabel(int classId, double xCenter, double yCenter, double width, double height)
+{
+    return QString("%1 %2 %3 %4 %5")
+        .arg(classId)
+        .arg(QString::number(xCenter, 'f', 6))
+        .arg(QString::number(yCenter, 'f', 6))
+        .arg(QString::number(width, 'f', 6))
+        .arg(QString::number(height, 'f', 6));
+}
+
+inline QString formatYoloLabel(const YoloLabel &label)
+{
+    return formatYoloLabel(label.classId, label.xCenter, label.yCenter, label.width, label.height);
+}
+
+inline bool parseYoloLabel(const QString &line, YoloLabel &label)
+{
+    QStringList parts = line.split(' ');
+    if (parts.size() != 5)
+        return false;
+
+    label.classId = parts[0].toInt();
+    label.xCenter = parts[1].toDouble();
+    label.yCenter = parts[2].toDouble();
+    label.width = parts[3].toDouble();
+    label.height = parts[4].toDouble();
+    return true;
+}
+
+// 라벨 파일 전체 (없으면 빈 목록)
+inline QVector<YoloLabel> readYoloLabels(const QString &path)
+{
+    QVector<YoloLabel> labels;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return labels;
+
+    QTextStream in(&file);
+    YoloLabel label;
+    while (!in.atEnd()) {
+        if (parseYoloLabel(in.readLine(), label))
+            labels.push_back(label);
+    }
+    return labels;
+}